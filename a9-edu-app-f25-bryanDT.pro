@@ -1,8 +1,8 @@
-QT       += core gui
+QT       += core gui concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
-CONFIG += c++17
+CONFIG += c++20
 
 # You can make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
@@ -11,30 +11,61 @@ CONFIG += c++17
 SOURCES += \
     basic_strategy_checker.cpp \
     card_sprites.cpp \
+    hand.cpp \
+    hand_history.cpp \
     cards_view.cpp \
+    counting_system.cpp \
+    dealer_outcome_cache.cpp \
+    decision_capture.cpp \
+    decision_export.cpp \
+    dealer_outcomes.cpp \
+    deviation_table.cpp \
+    expected_value_calculator.cpp \
+    game_clock.cpp \
     game_widget.cpp \
     blackjack_game.cpp \
     learn_widget.cpp \
     main.cpp \
     mainwindow.cpp \
-    card.cpp \
+    random_source.cpp \
+    round_engine.cpp \
     ruleset_widget.cpp \
+    session_log.cpp \
     shoe.cpp \
-    strategy_chart_dialog.cpp
+    strategy_chart_dialog.cpp \
+    strategy_solver.cpp \
+    strategy_tables.cpp
 
 HEADERS += \
     basic_strategy_checker.h \
     card_sprites.h \
+    hand.h \
+    hand_history.h \
     cards_view.h \
+    composition.h \
+    counting_system.h \
+    dealer_outcome_cache.h \
+    decision_capture.h \
+    decision_export.h \
+    dealer_outcomes.h \
+    deviation_table.h \
+    expected_value_calculator.h \
+    game_clock.h \
     game_widget.h \
     blackjack_game.h \
     learn_widget.h \
     mainwindow.h \
+    random_source.h \
     ruleset.h \
     card.h \
+    round_engine.h \
+    round_task.h \
     ruleset_widget.h \
+    session_log.h \
     shoe.h \
-    strategy_chart_dialog.h
+    strategy_chart_dialog.h \
+    strategy_solver.h \
+    strategy_tables.h
 
 FORMS += \
     game_widget.ui \
@@ -0,0 +1,300 @@
+#include "bankroll_simulator.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <QStringList>
+
+namespace {
+
+/// @brief The number of shoe streams each session may use, so every session's shoes are
+/// seeded from streams no other session uses.
+constexpr quint64 STREAMS_PER_SESSION = quint64(1) << 32;
+
+}
+
+// Bet ramps
+
+bool BetRamp::parse(const QString& text, BetRamp& ramp) {
+    QStringList parts = text.split('@');
+    CountingSystem::Id system = CountingSystem::Id::HiLo;
+    if (parts.size() > 2 || (parts.size() == 2 && !CountingSystem::fromKey(parts[1], system)))
+        return false;
+
+    QStringList fields = parts[0].split(':');
+    if (fields.size() != 3 && fields.size() != 5)
+        return false;
+    QStringList units = fields[0].split('-');
+    if (units.size() != 2)
+        return false;
+
+    BetRamp parsed;
+    bool ok[5] = { true, true, true, true, true };
+    parsed.minUnits = units[0].toInt(&ok[0]);
+    parsed.maxUnits = units[1].toInt(&ok[1]);
+    parsed.rampStart = fields[1].toInt(&ok[2]);
+    parsed.unitsPerCount = fields[2].toInt(&ok[3]);
+    parsed.countingSystem = system;
+    parsed.wongOut = fields.size() == 5;
+    if (parsed.wongOut) {
+        bool outOk, inOk;
+        parsed.wongOutBelow = fields[3].toInt(&outOk);
+        parsed.wongInAt = fields[4].toInt(&inOk);
+        ok[4] = outOk && inOk && parsed.wongInAt >= parsed.wongOutBelow;
+    }
+    if (!std::all_of(ok, ok + 5, [](bool b) { return b; }) || parsed.minUnits < 1
+        || parsed.maxUnits < parsed.minUnits || parsed.unitsPerCount < 0)
+        return false;
+    ramp = parsed;
+    return true;
+}
+
+QString BetRamp::toString() const {
+    QString text = QString("%1-%2:%3:%4").arg(minUnits).arg(maxUnits).arg(rampStart).arg(unitsPerCount);
+    if (wongOut)
+        text += QString(":%1:%2").arg(wongOutBelow).arg(wongInAt);
+    if (countingSystem != CountingSystem::Id::HiLo)
+        text += QString("@") + CountingSystem::get(countingSystem).key;
+    return text;
+}
+
+// Totals
+
+void BankrollStats::merge(const BankrollStats& other) {
+    rounds += other.rounds;
+    roundsSatOut += other.roundsSatOut;
+    unitsBet += other.unitsBet;
+    netWinnings += other.netWinnings;
+    netWinningsSquared += other.netWinningsSquared;
+    sessions += other.sessions;
+    ruinedSessions += other.ruinedSessions;
+}
+
+double BankrollStats::meanPerRound() const {
+    if (rounds == 0) return 0;
+    return static_cast<double>(netWinnings) / (static_cast<double>(rounds) * HouseEdgeSimulator::BET_UNIT);
+}
+
+double BankrollStats::variancePerRound() const {
+    if (rounds < 2) return 0;
+    double n = static_cast<double>(rounds);
+    double mean = netWinnings / n;
+    double sampleVariance = (netWinningsSquared - n * mean * mean) / (n - 1);
+    return sampleVariance / (static_cast<double>(HouseEdgeSimulator::BET_UNIT) * HouseEdgeSimulator::BET_UNIT);
+}
+
+double BankrollStats::winRatePer100() const {
+    return 100 * meanPerRound();
+}
+
+double BankrollStats::standardDeviationPer100() const {
+    return std::sqrt(100 * variancePerRound());
+}
+
+double BankrollStats::n0() const {
+    double mean = meanPerRound();
+    if (mean <= 0) return std::numeric_limits<double>::infinity();
+    return variancePerRound() / (mean * mean);
+}
+
+double BankrollStats::score() const {
+    // Kelly betting with a bankroll B wins B * mean^2 / variance per round
+    double mean = meanPerRound();
+    double variance = variancePerRound();
+    if (mean <= 0 || variance <= 0) return 0;
+    return 100 * 10000 * mean * mean / variance;
+}
+
+double BankrollStats::averageBet() const {
+    if (rounds == 0) return 0;
+    return static_cast<double>(unitsBet) / rounds;
+}
+
+double BankrollStats::ruinFraction() const {
+    if (sessions == 0) return 0;
+    return static_cast<double>(ruinedSessions) / sessions;
+}
+
+// Simulation
+
+BankrollSimulator::Worker::Worker(const Ruleset& rules, std::unique_ptr<PlayerStrategy> strategy, int rampCount) :
+    engine(rules, HouseEdgeSimulator::SIMULATION_BALANCE), strategy(std::move(strategy)), counts(rules.numDecks),
+    stats(rampCount), sessionStats(rampCount), bankrolls(rampCount), trueCounts(rampCount), seated(rampCount),
+    ruined(rampCount)
+{}
+
+BankrollSimulator::BankrollSimulator(const Ruleset& rules, const QVector<BetRamp>& ramps,
+                                     HouseEdgeSimulator::StrategyFactory strategyFactory) :
+    rules_(rules), ramps_(ramps), strategyFactory_(std::move(strategyFactory)), roundsPlayed_(0),
+    sessions_(0), roundsPerSession_(0) {
+    if (!strategyFactory_)
+        strategyFactory_ = HouseEdgeSimulator::createBasicStrategy;
+}
+
+QVector<BankrollStats> BankrollSimulator::run(qint64 sessions, qint64 roundsPerSession, int bankrollUnits,
+                                              int threads, quint64 seed) {
+    sessions = qBound<qint64>(1, sessions, WorkStealingScheduler::MAX_TASKS);
+    threads = static_cast<int>(qBound<qint64>(1, threads, sessions));
+    sessions_ = sessions;
+    roundsPerSession_ = qMax<qint64>(CHECKPOINT_COUNT, roundsPerSession);
+    trajectories_.assign(static_cast<std::size_t>(ramps_.size()) * sessions * CHECKPOINT_COUNT, 0);
+    ruinCheckpoints_.assign(static_cast<std::size_t>(ramps_.size()) * sessions, CHECKPOINT_COUNT);
+    sessionsPlayed_.assign(sessions, false);
+
+    std::vector<Worker> workers;
+    workers.reserve(threads);
+    for (int i = 0; i < threads; ++i)
+        workers.emplace_back(rules_, strategyFactory_(rules_), ramps_.size());
+
+    roundsPlayed_ = 0;
+    qint64 startingBankroll = static_cast<qint64>(bankrollUnits) * HouseEdgeSimulator::BET_UNIT;
+    scheduler_.run(sessions, threads, [this, &workers, seed, startingBankroll](int worker, qint64 session) {
+        Worker& state = workers[worker];
+        std::fill(state.bankrolls.begin(), state.bankrolls.end(), startingBankroll);
+        if (runSession(state, seed, session))
+            roundsPlayed_.fetch_add(roundsPerSession_, std::memory_order_relaxed);
+    });
+
+    QVector<BankrollStats> totals(ramps_.size());
+    for (const Worker& worker : workers) {
+        for (int i = 0; i < ramps_.size(); ++i)
+            totals[i].merge(worker.stats[i]);
+    }
+    return totals;
+}
+
+void BankrollSimulator::cancel() {
+    scheduler_.cancel();
+}
+
+bool BankrollSimulator::isCancelled() const {
+    return scheduler_.isCancelled();
+}
+
+double BankrollSimulator::getProgress() const {
+    qint64 sessions = scheduler_.getTaskCount();
+    if (sessions == 0) return 0;
+    return static_cast<double>(scheduler_.getCompletedTasks()) / sessions;
+}
+
+qint64 BankrollSimulator::getRoundsPlayed() const {
+    return roundsPlayed_.load(std::memory_order_relaxed);
+}
+
+qint64 BankrollSimulator::getCheckpointRound(int checkpoint) const {
+    return roundsPerSession_ * (checkpoint + 1) / CHECKPOINT_COUNT;
+}
+
+double BankrollSimulator::getBankrollPercentile(int ramp, int checkpoint, double percentile) const {
+    std::vector<qint64> bankrolls;
+    bankrolls.reserve(sessions_);
+    for (qint64 session = 0; session < sessions_; ++session) {
+        if (sessionsPlayed_[session])
+            bankrolls.push_back(trajectories_[getTrajectoryIndex(ramp, session, checkpoint)]);
+    }
+    if (bankrolls.empty()) return 0;
+
+    std::size_t rank = static_cast<std::size_t>(std::lround(qBound(0.0, percentile, 100.0) / 100 * (bankrolls.size() - 1)));
+    std::nth_element(bankrolls.begin(), bankrolls.begin() + rank, bankrolls.end());
+    return static_cast<double>(bankrolls[rank]) / HouseEdgeSimulator::BET_UNIT;
+}
+
+double BankrollSimulator::getRuinFractionAt(int ramp, int checkpoint) const {
+    qint64 played = 0;
+    qint64 ruined = 0;
+    for (qint64 session = 0; session < sessions_; ++session) {
+        if (!sessionsPlayed_[session])
+            continue;
+        played++;
+        if (ruinCheckpoints_[static_cast<std::size_t>(ramp) * sessions_ + session] <= checkpoint)
+            ruined++;
+    }
+    if (played == 0) return 0;
+    return static_cast<double>(ruined) / played;
+}
+
+bool BankrollSimulator::runSession(Worker& worker, quint64 seed, qint64 session) {
+    RoundEngine& engine = worker.engine;
+    PlayerStrategy& strategy = *worker.strategy;
+    int rampCount = ramps_.size();
+    std::fill(worker.sessionStats.begin(), worker.sessionStats.end(), BankrollStats());
+    std::fill(worker.seated.begin(), worker.seated.end(), true);
+    std::fill(worker.ruined.begin(), worker.ruined.end(), false);
+    auto decide = [&strategy](const RoundEngine& engine) {
+        return strategy.chooseAction(engine);
+    };
+
+    quint64 stream = static_cast<quint64>(session) * STREAMS_PER_SESSION;
+    engine.seedShoe(seed, stream++);
+    worker.counts.reset();
+    int checkpoint = 0;
+    qint64 nextCheckpointRound = getCheckpointRound(0);
+    for (qint64 round = 1; round <= roundsPerSession_; ++round) {
+        if (engine.getNeedsShuffling()) {
+            engine.seedShoe(seed, stream++);
+            worker.counts.reset();
+        }
+
+        // Between rounds every card out of the shoe has been seen, including the last
+        // round's hole card, so every count is read before the round is dealt
+        for (int i = 0; i < rampCount; ++i)
+            worker.trueCounts[i] = static_cast<int>(std::floor(worker.counts.getTrueCount(ramps_[i].countingSystem)));
+        engine.setBalance(HouseEdgeSimulator::SIMULATION_BALANCE);
+        qint64 net = engine.playRound(HouseEdgeSimulator::BET_UNIT, decide);
+        worker.counts.observeRound(engine);
+
+        for (int i = 0; i < rampCount; ++i) {
+            const BetRamp& ramp = ramps_[i];
+            BankrollStats& stats = worker.sessionStats[i];
+            int trueCount = worker.trueCounts[i];
+            if (ramp.wongOut) {
+                if (worker.seated[i] && trueCount < ramp.wongOutBelow)
+                    worker.seated[i] = false;
+                else if (!worker.seated[i] && trueCount >= ramp.wongInAt)
+                    worker.seated[i] = true;
+                if (!worker.seated[i]) {
+                    stats.roundsSatOut++;
+                    continue;
+                }
+            }
+
+            int units = ramp.getUnits(trueCount);
+            qint64 rampNet = net * units;
+            stats.rounds++;
+            stats.unitsBet += units;
+            stats.netWinnings += rampNet;
+            stats.netWinningsSquared += rampNet * rampNet;
+            if (worker.ruined[i])
+                continue;
+
+            // Doubles and splits can lose more than the initial bet, but never more than
+            // the bankroll
+            qint64& bankroll = worker.bankrolls[i];
+            bool covered = bankroll >= static_cast<qint64>(units) * HouseEdgeSimulator::BET_UNIT;
+            if (covered)
+                bankroll += rampNet;
+            if (!covered || bankroll < 0) {
+                bankroll = qMax<qint64>(0, bankroll);
+                worker.ruined[i] = true;
+                ruinCheckpoints_[static_cast<std::size_t>(i) * sessions_ + session] = static_cast<qint8>(checkpoint);
+            }
+        }
+
+        if (round == nextCheckpointRound) {
+            for (int i = 0; i < rampCount; ++i)
+                trajectories_[getTrajectoryIndex(i, session, checkpoint)] = worker.bankrolls[i];
+            checkpoint++;
+            if (checkpoint < CHECKPOINT_COUNT)
+                nextCheckpointRound = getCheckpointRound(checkpoint);
+        }
+        if (scheduler_.isCancelled())
+            return false;
+    }
+
+    for (int i = 0; i < rampCount; ++i) {
+        worker.sessionStats[i].sessions = 1;
+        worker.sessionStats[i].ruinedSessions = worker.ruined[i] ? 1 : 0;
+        worker.stats[i].merge(worker.sessionStats[i]);
+    }
+    sessionsPlayed_[session] = true;
+    return true;
+}
@@ -0,0 +1,263 @@
+#ifndef BANKROLL_SIMULATOR_H
+#define BANKROLL_SIMULATOR_H
+
+#include <atomic>
+#include <vector>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include "counting_system.h"
+#include "house_edge_simulator.h"
+#include "round_engine.h"
+#include "ruleset.h"
+#include "work_stealing_scheduler.h"
+
+/// @brief A betting strategy for a card counter: the initial bet of each round, in units,
+/// as a function of the true count at the start of the round in one of the counting
+/// systems (Hi-Lo unless given), optionally sitting out ("wonging out") while the count is
+/// low.
+struct BetRamp {
+    /// @brief The bet below rampStart.
+    int minUnits = 1;
+
+    /// @brief The largest bet.
+    int maxUnits = 8;
+
+    /// @brief The lowest true count at which the bet is raised above minUnits.
+    int rampStart = 1;
+
+    /// @brief How much the bet rises for each true count from rampStart.
+    int unitsPerCount = 1;
+
+    /// @brief True to sit out rounds while the count is low.
+    bool wongOut = false;
+
+    /// @brief While playing, the player sits out once the true count drops below this.
+    int wongOutBelow = -1;
+
+    /// @brief While sitting out, the player plays again once the true count reaches this.
+    int wongInAt = 1;
+
+    /// @brief The count the bets follow.
+    CountingSystem::Id countingSystem = CountingSystem::Id::HiLo;
+
+    /// @brief Gets the bet for a round.
+    /// @param trueCount The true count at the start of the round, rounded down.
+    int getUnits(int trueCount) const {
+        if (trueCount < rampStart)
+            return minUnits;
+        return qMin(maxUnits, minUnits + (trueCount - rampStart + 1) * unitsPerCount);
+    }
+
+    /// @brief Reads a ramp written as "min-max:start:step", optionally followed by
+    /// ":out:in" to wong out below the true count out and back in at in, and by "@system"
+    /// to follow a counting system other than Hi-Lo (e.g., "1-12:2:2:-1:1@halves").
+    /// @param text The ramp.
+    /// @param ramp Receives the ramp if the text is valid.
+    /// @return True if the text is a valid ramp.
+    static bool parse(const QString& text, BetRamp& ramp);
+
+    /// @brief Writes the ramp in the form parse reads.
+    QString toString() const;
+};
+
+/// @brief Totals for one BetRamp over every session of a BankrollSimulator run. Net
+/// winnings are in chips, where one unit is HouseEdgeSimulator::BET_UNIT chips. The
+/// per-round totals include every round the ramp played, whether or not the session's
+/// bankroll had run out, so they describe the ramp itself; the bankroll only decides
+/// which sessions are ruined.
+struct BankrollStats {
+    /// @brief The number of rounds played.
+    qint64 rounds = 0;
+
+    /// @brief The number of rounds sat out by wonging out.
+    qint64 roundsSatOut = 0;
+
+    /// @brief The sum of the initial bets, in units.
+    qint64 unitsBet = 0;
+
+    /// @brief The sum of the net winnings over every round played.
+    qint64 netWinnings = 0;
+
+    /// @brief The sum of the squares of the net winnings for each round played.
+    qint64 netWinningsSquared = 0;
+
+    /// @brief The number of sessions played.
+    qint64 sessions = 0;
+
+    /// @brief The number of sessions in which the bankroll could not cover a bet, or a
+    /// round lost more than was left of it.
+    qint64 ruinedSessions = 0;
+
+    /// @brief Adds another set of totals into this one.
+    void merge(const BankrollStats& other);
+
+    /// @brief Gets the expected win per 100 rounds played, in units.
+    double winRatePer100() const;
+
+    /// @brief Gets the standard deviation of the result of 100 rounds played, in units.
+    double standardDeviationPer100() const;
+
+    /// @brief Gets N0: the number of rounds after which the expected win equals one
+    /// standard deviation of the result. Infinite if the expected win is not positive.
+    double n0() const;
+
+    /// @brief Gets SCORE: the expected win per 100 rounds, in units, of a player with a
+    /// bankroll of 10,000 units who sizes bets by the Kelly criterion. 0 if the expected
+    /// win is not positive.
+    double score() const;
+
+    /// @brief Gets the average initial bet of the rounds played, in units.
+    double averageBet() const;
+
+    /// @brief Gets the fraction of sessions that were ruined.
+    double ruinFraction() const;
+
+private:
+    /// @brief Gets the mean net winnings per round played, in units.
+    double meanPerRound() const;
+
+    /// @brief Gets the variance of the net winnings per round played, in units squared.
+    double variancePerRound() const;
+};
+
+/// @brief Simulates a card counter's bankroll over many independent sessions, for several
+/// BetRamps at once.
+///
+/// The strategy plays every hand for one unit, and a round's net winnings scale exactly
+/// with its initial bet, so each round is played once and its result multiplied by each
+/// ramp's bet at the round's true count. Every ramp therefore sees exactly the same
+/// cards, and adding a ramp costs a multiplication per round instead of another
+/// simulation. A CountTracker keeps every counting system's count from the same cards, so
+/// ramps following different systems are compared on the same rounds too.
+///
+/// Each session deals the given number of rounds from fresh shoes and is one task for a
+/// WorkStealingScheduler. A session's shoes are seeded from the seed and the session's
+/// index, so results are the same for any number of threads. Besides the merged totals,
+/// each session's bankroll is kept at CHECKPOINT_COUNT evenly spaced rounds, giving the
+/// spread of bankroll trajectories.
+class BankrollSimulator {
+public:
+    /// @brief The number of points at which each session's bankroll is kept.
+    static constexpr int CHECKPOINT_COUNT = 20;
+
+    /// @brief Creates a new BankrollSimulator.
+    /// @param rules The rules to simulate.
+    /// @param ramps The betting strategies to compare.
+    /// @param strategyFactory Creates the playing strategy of each thread. If empty, the
+    /// threads play basic strategy.
+    BankrollSimulator(const Ruleset& rules, const QVector<BetRamp>& ramps,
+                      HouseEdgeSimulator::StrategyFactory strategyFactory = nullptr);
+
+    /// @brief Simulates sessions for every ramp.
+    /// @param sessions The number of sessions.
+    /// @param roundsPerSession The number of rounds dealt in each session, including those
+    /// sat out.
+    /// @param bankrollUnits The bankroll each session starts with, in units.
+    /// @param threads The number of threads to play on (at least 1).
+    /// @param seed The seed for the shoes.
+    /// @return The totals for each ramp, in the order of the ramps.
+    QVector<BankrollStats> run(qint64 sessions, qint64 roundsPerSession, int bankrollUnits, int threads,
+                               quint64 seed);
+
+    /// @brief Stops the current run after the sessions in progress. May be called from any
+    /// thread.
+    void cancel();
+
+    /// @brief Returns true if the current (or last) run was cancelled.
+    bool isCancelled() const;
+
+    /// @brief Gets the fraction of the current run's sessions that have been played, from
+    /// 0 to 1. May be called from any thread.
+    double getProgress() const;
+
+    /// @brief Gets the number of rounds dealt so far in the current run, counting only
+    /// finished sessions. May be called from any thread.
+    qint64 getRoundsPlayed() const;
+
+    /// @brief Gets the round at which a checkpoint is taken in each session of the last
+    /// run.
+    /// @param checkpoint The index of the checkpoint.
+    qint64 getCheckpointRound(int checkpoint) const;
+
+    /// @brief Gets a percentile of the sessions' bankrolls at a checkpoint of the last
+    /// run. Sessions not played because the run was cancelled are left out.
+    /// @param ramp The index of the ramp.
+    /// @param checkpoint The index of the checkpoint.
+    /// @param percentile The percentile, from 0 to 100.
+    /// @return The bankroll, in units.
+    double getBankrollPercentile(int ramp, int checkpoint, double percentile) const;
+
+    /// @brief Gets the fraction of the last run's sessions ruined by a checkpoint.
+    /// @param ramp The index of the ramp.
+    /// @param checkpoint The index of the checkpoint.
+    double getRuinFractionAt(int ramp, int checkpoint) const;
+
+private:
+    /// @brief The engine, strategy, and totals of one thread, on their own cache lines.
+    struct alignas(64) Worker {
+        Worker(const Ruleset& rules, std::unique_ptr<PlayerStrategy> strategy, int rampCount);
+
+        RoundEngine engine;
+        std::unique_ptr<PlayerStrategy> strategy;
+        CountTracker counts;
+        std::vector<BankrollStats> stats;
+
+        /// @brief The totals of each ramp in the current session, added to stats once the
+        /// session is played to the end.
+        std::vector<BankrollStats> sessionStats;
+
+        /// @brief The state of each ramp in the current session.
+        std::vector<qint64> bankrolls;
+        std::vector<int> trueCounts;
+        std::vector<char> seated;
+        std::vector<char> ruined;
+    };
+
+    /// @brief Plays one session on the calling thread.
+    /// @param worker The calling thread's worker.
+    /// @param seed The seed for the simulation.
+    /// @param session The index of the session.
+    /// @return True if the session was played to the end, false if the run was cancelled
+    /// first (in which case none of its totals are kept).
+    bool runSession(Worker& worker, quint64 seed, qint64 session);
+
+    /// @brief Gets the index of a session's bankroll at a checkpoint in trajectories_.
+    std::size_t getTrajectoryIndex(int ramp, qint64 session, int checkpoint) const {
+        return (static_cast<std::size_t>(ramp) * sessions_ + session) * CHECKPOINT_COUNT + checkpoint;
+    }
+
+    /// @brief The rules to simulate.
+    Ruleset rules_;
+
+    /// @brief The betting strategies to compare.
+    QVector<BetRamp> ramps_;
+
+    /// @brief Creates the playing strategy for each thread.
+    HouseEdgeSimulator::StrategyFactory strategyFactory_;
+
+    /// @brief Shares the sessions among the threads.
+    WorkStealingScheduler scheduler_;
+
+    /// @brief The number of rounds in the current run's finished sessions.
+    std::atomic<qint64> roundsPlayed_;
+
+    /// @brief The number of sessions in the last run.
+    qint64 sessions_;
+
+    /// @brief The number of rounds in each session of the last run.
+    qint64 roundsPerSession_;
+
+    /// @brief The bankroll, in chips, of each ramp and session at each checkpoint. A
+    /// ruined session keeps what was left of its bankroll, never less than 0.
+    std::vector<qint64> trajectories_;
+
+    /// @brief The first checkpoint at or after which each ramp and session was ruined, or
+    /// CHECKPOINT_COUNT if it never was.
+    std::vector<qint8> ruinCheckpoints_;
+
+    /// @brief Whether each session of the last run was played.
+    std::vector<char> sessionsPlayed_;
+};
+
+#endif // BANKROLL_SIMULATOR_H
@@ -1,19 +1,29 @@
 #ifndef BASIC_STRATEGY_CHECKER_H
 #define BASIC_STRATEGY_CHECKER_H
 
-#include <QVector>
 #include "card.h"
-#include <tuple>
-
-/// @brief Holds the BlackJack basic strategy plays for H17 and S17, allowing one to
-/// find the optimal play for a given hand and dealer upcard.
+#include "hand.h"
+#include "ruleset.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+
+/// @brief Holds the BlackJack basic strategy plays for a ruleset, allowing one to find the
+/// optimal play for a given hand and dealer upcard.
+///
+/// The plays come from a MoveTable generated at compile time for the ruleset's dealer
+/// soft-17 rule, double after split, surrender, and deck count (see strategy_tables.h), or
+/// from a table solved at run time for the full ruleset (see StrategySolver).
+/// The table is indexed by a hand key (the hand's hard total, soft total, or pair) and the
+/// dealer's upcard, so every query is one lookup in a table of about a kilobyte.
 class BasicStrategyChecker {
 public:
     /// @brief Defines the possible actions a player can take for a hand. One of the
     /// enumerations, SplitIfDas, is not a real action—this value indicates that the
     /// player should split only if double after split (DAS) is allowed under the
-    /// current ruleset.
-    enum class PlayerAction {
+    /// current ruleset. The generated tables already account for DAS, so they never
+    /// contain it.
+    enum class PlayerAction : std::uint8_t {
         Hit,
         Stand,
         Double,
@@ -22,16 +32,65 @@ public:
         Surrender
     };
 
+    /// @brief The best, second-best, and third-best moves for a hand. Each move is what
+    /// to do if the moves before it cannot be made; e.g., for [8, 8] against an ace in
+    /// H17, the player should surrender, or split if they cannot surrender, or hit if they
+    /// cannot split either. Once the chain reaches Hit or Stand, which can always be made,
+    /// the remaining moves repeat it.
+    struct MoveChain {
+        PlayerAction best;
+        PlayerAction second;
+        PlayerAction third;
+    };
+
+    /// @brief The first hand key for hard totals (4-21, inclusive).
+    static constexpr int HARD_TOTALS_KEY = 0;
+
+    /// @brief The first hand key for soft totals (12-21, inclusive).
+    static constexpr int SOFT_TOTALS_KEY = 18;
+
+    /// @brief The first hand key for pairs (2-10, then ace).
+    static constexpr int SPLITTING_KEY = 28;
+
+    /// @brief The number of hand keys.
+    static constexpr int HAND_KEY_COUNT = 38;
+
+    /// @brief The moves for each hand key (rows) and dealer upcard (columns; 2-10, then
+    /// ace, with face cards counting as 10).
+    using MoveTable = std::array<std::array<MoveChain, 10>, HAND_KEY_COUNT>;
+
     /// @brief Initializes a new BasicStrategyChecker.
-    /// @param dealaerHitsSoft17 Indicates whether the dealer hits (true) or
-    /// stands (false) on soft 17, based on the ruleset.
-    BasicStrategyChecker(bool dealerHitsSoft17 = true);
+    /// @param rules The rules of the game, which determine the strategy table used.
+    explicit BasicStrategyChecker(const Ruleset& rules = Ruleset());
+
+    /// @brief Initializes a new BasicStrategyChecker from a solved table.
+    /// @param table The table, which the checker shares ownership of.
+    explicit BasicStrategyChecker(std::shared_ptr<const MoveTable> table);
+
+    /// @brief Gets the best, second-best, and third-best moves for the given player hand
+    /// against the dealer's upcard.
+    /// @param hand The player's hand, which must not be bust.
+    /// @param dealerUpcard The dealer's first drawn card (the upcard).
+    /// @return The moves for the given hand against the dealer's upcard.
+    MoveChain getMoves(const Hand& hand, Card dealerUpcard) const {
+        return getMoves(getHandKey(hand), getUpcardIndex(dealerUpcard));
+    }
+
+    /// @brief Gets the moves for one cell of the strategy table.
+    /// @param handKey The hand key (see getHandKey).
+    /// @param upcardColumn The column of the dealer's upcard (see getUpcardIndex).
+    /// @return The moves for the cell.
+    MoveChain getMoves(int handKey, int upcardColumn) const {
+        return (*moves_)[handKey][upcardColumn];
+    }
 
     /// @brief Gets the best move for the given player hand against the dealer's upcard.
     /// @param hand The list of cards in the player's hand.
     /// @param dealerUpcard The dealer's first drawn card (the upcard).
     /// @return The best move for the given hand against the dealer's upcard.
-    PlayerAction getBestMove(const QVector<Card>& hand, Card dealerUpcard) const;
+    PlayerAction getBestMove(const Hand& hand, Card dealerUpcard) const {
+        return getMoves(hand, dealerUpcard).best;
+    }
 
     /// @brief Gets the second-best move for the given player hand against the dealer's
     /// upcard. If there is no second-best move (i.e. the best move is always possible),
@@ -40,174 +99,62 @@ public:
     /// @param dealerUpcard The dealer's first drawn card (the upcard).
     /// @return The second-best move for the given hand against the dealer's upcard, or
     /// the best move if no second-best move is necessary.
-    PlayerAction getSecondBestMove(const QVector<Card>& hand, Card dealerUpcard) const;
+    PlayerAction getSecondBestMove(const Hand& hand, Card dealerUpcard) const {
+        return getMoves(hand, dealerUpcard).second;
+    }
 
     /// @brief Gets the third-best move for the given player hand against the dealer's
-    /// upcard. For almost every possible hand, the second-best move will always be
-    /// possible, so this method will return the same result as getSecondBestMove. The
-    /// only exception is [8, 8] against the dealer's ace in the H17 ruleset, in which
-    /// case the best move is to surrender, the second-best is to split, and the third-
-    /// best is to hit. Thus, the only case where this method's result is different
-    /// from getSecondBestMove is in this scenario.
+    /// upcard. For most hands, the second-best move will always be possible, so this
+    /// method will return the same result as getSecondBestMove. The exceptions are
+    /// [8, 8] against the dealer's ace in the H17 ruleset (surrender, then split, then
+    /// hit) and pairs whose fallback from splitting is to double (e.g., [A, A] against a
+    /// 6: split, then double, then hit).
     /// @param hand The lsit of cards in the player's hand.
     /// @param dealerUpcard The dealer's first drawn card (the upcard).
-    /// @return The second-best move for the given hand against the dealer's upcard, or
-    /// the best move if no second-best move is necessary.
-    PlayerAction getThirdBestMove(const QVector<Card>& hand, Card dealerUpcard) const;
-
-private:
-    /// @brief The optimal actions for any hand with a hard total in the H17 ruleset. The
-    /// rows (first indices) represent the player's hard total (from 4 to 20, inclusive),
-    /// while the columns represent the dealer's upcard (2-10, then ace; face cards count
-    /// as 10).
-    static constexpr PlayerAction H17_HARD_TOTALS[17][10] {
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Surrender,PlayerAction::Surrender },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Surrender,PlayerAction::Surrender,PlayerAction::Surrender },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Surrender },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand }
-    };
-
-    /// @brief The optimal actions for any hand with a soft total in the H17 ruleset. The
-    /// rows (first indices) represent the player's soft total, from 12 (A, A) to 20 (A,
-    /// 9) inclusive (soft 12 is included in case the player cannot split). The columns
-    /// (second indices) represent the dealer's upcard (2-10, then ace; face cards count
-    /// as 10).
-    static constexpr PlayerAction H17_SOFT_TOTALS[9][10] {
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Hit, PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Double, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand }
-    };
-
-    /// @brief The optimal actions for any hand with two cards of the same rank in the H17
-    /// ruleset. The rows (first indices) represent the rank of card (2-10, then ace; face
-    /// cards count as 10), and the columns (second indices) represent the dealer's upcard
-    /// (2-10, then ace, with face cards counting as 10.
-    static constexpr PlayerAction H17_SPLITTING[10][10] {
-        { PlayerAction::SplitIfDas, PlayerAction::SplitIfDas, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::SplitIfDas, PlayerAction::SplitIfDas, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::SplitIfDas, PlayerAction::SplitIfDas, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand },
-        { PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::SplitIfDas, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Surrender },
-        { PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Stand, PlayerAction::Split, PlayerAction::Split, PlayerAction::Stand, PlayerAction::Stand },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Double, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand },
-        { PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split },
-    };
-
-    /// @brief The optimal actions for any hand with a hard total in the S17 ruleset. The
-    /// rows (first indices) represent the player's hard total (from 4 to 20, inclusive),
-    /// while the columns represent the dealer's upcard (2-10, then ace; face cards count
-    /// as 10).
-    static constexpr PlayerAction S17_HARD_TOTALS[17][10] {
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Surrender,PlayerAction::Hit },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Hit,PlayerAction::Hit,PlayerAction::Surrender,PlayerAction::Surrender,PlayerAction::Surrender },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand }
-    };
-
-    /// @brief The optimal actions for any hand with a soft total in the S17 ruleset. The
-    /// rows (first indices) represent the player's soft total, from 12 (A, A) to 20 (A,
-    /// 9) inclusive (soft 12 is included in case the player cannot split). The columns
-    /// (second indices) represent the dealer's upcard (2-10, then ace; face cards count
-    /// as 10).
-    static constexpr PlayerAction S17_SOFT_TOTALS[9][10] {
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Hit, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Stand, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Hit, PlayerAction::Hit,PlayerAction::Hit },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand }
-    };
-
-    /// @brief The optimal actions for any hand with two cards of the same rank in the S17
-    /// ruleset. The rows (first indices) represent the rank of card (2-10, then ace; face
-    /// cards count as 10), and the columns (second indices) represent the dealer's upcard
-    /// (2-10, then ace, with face cards counting as 10.
-    ///
-    /// S17 splitting strategy is the same as H17 except for [8, 8] against a dealer's ace,
-    /// in which case the player should stand in S17 but surrender in H17.
-    static constexpr PlayerAction S17_SPLITTING[10][10] {
-        { PlayerAction::SplitIfDas, PlayerAction::SplitIfDas, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::SplitIfDas, PlayerAction::SplitIfDas, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::SplitIfDas, PlayerAction::SplitIfDas, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand },
-        { PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Double, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::SplitIfDas, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit, PlayerAction::Hit },
-        { PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split },
-        { PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Stand, PlayerAction::Split, PlayerAction::Split, PlayerAction::Stand, PlayerAction::Stand },
-        { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Double, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand },
-        { PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split, PlayerAction::Split },
-    };
-
-    /// @brief Indicates whether to use the H17 ruleset (true) or the S17 ruleset (false).
-    bool dealerHitsSoft17_;
+    /// @return The third-best move for the given hand against the dealer's upcard, or
+    /// the second-best move if no third-best move is necessary.
+    PlayerAction getThirdBestMove(const Hand& hand, Card dealerUpcard) const {
+        return getMoves(hand, dealerUpcard).third;
+    }
 
     /// @brief Gets the column index for any of the basic strategy tables based on the
     /// dealer's upcard.
     /// @param dealerUpcard The dealer's upcard.
     /// @return A valid column index (0-9, inclusive) for any of the basic strategy tables
     /// based on the rank of the dealer's upcard.
-    static inline int getUpcardIndex(Card dealerUpcard);
-
-    /// @brief Gets the row index (first index) for the H17/S17 hard totals table based on
-    /// the hand total.
-    /// @param handTotal The hard total of the hand (4-20, inclusive).
-    /// @return The row index for the hard totals table (0-18, inclusive).
-    static inline int getHardTotalsRowIndex(int handTotal);
-
-    /// @brief Gets the row index (first index) for either of the soft totals tables based
-    /// on the soft total of the hand (the total if counting ace as 11).
-    /// @param softTotal The total value of the hand if counting ace as 11 (12-20, inclusive).
-    /// @return A valid row index for the soft totals table (0-8, inclusive).
-    static inline int getSoftTotalsRowIndex(int softTotal);
-
-    /// @brief Gets the row index (first index) for either of the splitting tables based
-    /// on the value of the two cards in the player's hand.
-    /// @param card A card from the player's hand (which card it is should not matter, as
-    /// they should both have the same value).
-    /// @return A valid row index for the splitting table (0-9, inclusive).
-    static inline int getSplittingRowIndex(Card card);
-
-    /// @brief Returns true if the hand can be split; i.e., it consts of only two cards,
-    /// each of which are the same rank. Otherwise, returns false.
-    /// @return True if the hand can be split, false otherwise.
-    static inline bool canSplit(const QVector<Card>& hand);
+    static int getUpcardIndex(Card dealerUpcard) {
+        return dealerUpcard.getBlackjackValue() - 2;
+    }
+
+    /// @brief Gets the hand key for a hard total.
+    /// @param total The hard total (4-21, inclusive).
+    static constexpr int getHardTotalKey(int total) { return HARD_TOTALS_KEY + total - 4; }
+
+    /// @brief Gets the hand key for a soft total.
+    /// @param total The soft total (12-21, inclusive).
+    static constexpr int getSoftTotalKey(int total) { return SOFT_TOTALS_KEY + total - 12; }
+
+    /// @brief Gets the hand key for a pair.
+    /// @param value The value of each card in the pair (2-10, or 11 for aces).
+    static constexpr int getPairKey(int value) { return SPLITTING_KEY + value - 2; }
+
+    /// @brief Gets the hand key (row index of a MoveTable) for a hand.
+    /// @param hand The player's hand, which must not be bust.
+    /// @return A valid hand key (0-37, inclusive).
+    static int getHandKey(const Hand& hand) {
+        if (hand.isPair())
+            return getPairKey(hand[0].getBlackjackValue());
+        if (hand.isSoft())
+            return getSoftTotalKey(hand.getValue());
+        return getHardTotalKey(hand.getValue());
+    }
+
+private:
+    /// @brief The strategy table for the ruleset.
+    const MoveTable* moves_;
+
+    /// @brief Keeps a solved table alive; null if moves_ is a compile-time table.
+    std::shared_ptr<const MoveTable> solvedMoves_;
 };
 
 #endif // BASIC_STRATEGY_CHECKER_H
@@ -0,0 +1,59 @@
+QT       = core
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = blackjack-simulator
+
+SOURCES += \
+    bankroll_simulator.cpp \
+    basic_strategy_checker.cpp \
+    counting_system.cpp \
+    dealer_outcome_cache.cpp \
+    dealer_outcomes.cpp \
+    decision_export.cpp \
+    deviation_table.cpp \
+    expected_value_calculator.cpp \
+    hand.cpp \
+    house_edge_simulator.cpp \
+    player_strategy.cpp \
+    random_source.cpp \
+    risk_of_ruin_estimator.cpp \
+    round_engine.cpp \
+    session_log.cpp \
+    session_replayer.cpp \
+    shoe.cpp \
+    simulator_main.cpp \
+    strategy_tables.cpp \
+    strategy_tournament.cpp \
+    work_stealing_scheduler.cpp
+
+HEADERS += \
+    bankroll_simulator.h \
+    basic_strategy_checker.h \
+    card.h \
+    composition.h \
+    counting_system.h \
+    dealer_outcome_cache.h \
+    dealer_outcomes.h \
+    decision_export.h \
+    deviation_table.h \
+    expected_value_calculator.h \
+    hand.h \
+    house_edge_simulator.h \
+    player_strategy.h \
+    random_source.h \
+    risk_of_ruin_estimator.h \
+    round_engine.h \
+    ruleset.h \
+    session_log.h \
+    session_replayer.h \
+    shoe.h \
+    strategy_tables.h \
+    strategy_tournament.h \
+    work_stealing_scheduler.h
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
@@ -1,326 +1,228 @@
 #include "blackjack_game.h"
 #include "shoe.h"
 #include "card.h"
+#include "strategy_solver.h"
+#include <cmath>
+#include <QDateTime>
+#include <QFutureWatcher>
+#include <QRandomGenerator>
+#include <QtConcurrent/QtConcurrentRun>
 
-BlackjackGame::BlackjackGame(QObject *parent) : QObject{parent},
-    rules_(), shoe_(new Shoe()),
-    balance_(1000), currentBetAmount_(0), needsShuffling_(true), hasRoundStarted_(false),
-    currentHandIndex_(0), resultHandIndex_(0), strategyChecker_(rules_.dealerHitsSoft17)
-{}
+BlackjackGame::BlackjackGame(QObject *parent, GameClock* clock) : QObject{parent},
+    clock_(clock ? clock : &GameClock::getDefault()), engine_(), counts_(engine_.getRuleset().numDecks),
+    strategyChecker_(engine_.getRuleset()),
+    deviations_(DeviationTable::forRuleset(strategyChecker_, engine_.getRuleset())), strategyGeneration_(0),
+    evCalculator_(engine_.getRuleset()) {
+    engine_.setObserver(this);
 
-void BlackjackGame::setRuleset(Ruleset rules) {
-    rules_ = rules;
+    // Seed the shoe explicitly, so the session can be replayed from its log
+    seedShoe(QRandomGenerator::global()->generate64());
 }
 
-void BlackjackGame::setShuffling(bool needsShuffling) {
-    needsShuffling_ = needsShuffling;
+GameClock& BlackjackGame::getClock() const {
+    return *clock_;
 }
 
-// Game start and Animation
-
-void BlackjackGame::beginRound(int betAmount) {
-    currentBetAmount_ = betAmount;
-    balance_ -= betAmount;
-
-    hasRoundStarted_ = true;
-
-    emit betPlaced(betAmount);
-    dealNewHand();
+void BlackjackGame::setRuleset(Ruleset rules) {
+    bool newShoe = rules.numDecks != engine_.getRuleset().numDecks;
+    engine_.setRuleset(rules);
+    if (newShoe)
+        counts_.reset(rules.numDecks);
+    evCalculator_ = ExpectedValueCalculator(rules);
+    log_.recordRuleset(rules);
+
+    // Hint from the compile-time table until the solved one is ready
+    strategyChecker_ = BasicStrategyChecker(rules);
+    deviations_ = DeviationTable::forRuleset(strategyChecker_, rules);
+    solveStrategy(rules);
+}
+
+void BlackjackGame::solveStrategy(const Ruleset& rules) {
+    using Table = std::shared_ptr<const BasicStrategyChecker::MoveTable>;
+    quint64 generation = ++strategyGeneration_;
+
+    auto* watcher = new QFutureWatcher<Table>(this);
+    connect(watcher, &QFutureWatcher<Table>::finished, this, [this, watcher, generation, rules]() {
+        if (generation == strategyGeneration_) {
+            strategyChecker_ = BasicStrategyChecker(watcher->result());
+            deviations_ = DeviationTable::forRuleset(strategyChecker_, rules);
+        }
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run([rules]() {
+        return StrategySolver::loadOrSolve(rules);
+    }));
 }
 
-void BlackjackGame::dealNewHand() {
-    // Check shuffling status.
-    if(needsShuffling_) {
-        shoe_->shuffle();
-        needsShuffling_ = false;
-    }
-
-    // Reset necessary elements.
-    playerHands_.clear();
-    playerHands_.append(QVector<Card>());
-    betAmounts_.clear();
-    betAmounts_.append(currentBetAmount_);
-    dealerHand_.clear();
-    currentHandIndex_ = 0;
-    runningCount_ = 0;
-
-    // Call the animated dealer
-    dealCards();
+void BlackjackGame::setShuffling(bool needsShuffling) {
+    engine_.setNeedsShuffling(needsShuffling);
+    log_.recordShuffle(needsShuffling);
 }
 
-void BlackjackGame::dealCards() {
-    int delay = 0;
-    const int step = 500;  // 500ms between cards
+// Game start and Animation
 
+void BlackjackGame::beginRound(int betAmount) {
+    // The round runs until its first wait; replacing a round still in progress
+    // destroys it, along with the delays it was waiting on
+    input_.clear();
+    round_ = playRound(betAmount);
+}
+
+RoundTask BlackjackGame::playRound(int betAmount) {
+    using PlayerAction = BasicStrategyChecker::PlayerAction;
+
+    // Takes the bet (emitting betPlaced), shuffles if necessary, and resets the hands.
+    // The count carries over from round to round until the shoe is shuffled.
+    if (engine_.getNeedsShuffling())
+        counts_.reset(engine_.getRuleset().numDecks);
+    engine_.startRound(betAmount);
+    log_.recordBet(betAmount);
+    roundRecord_ = HandHistoryRecord();
+
+    // Deal once the UI has finished taking the bet, alternating player and dealer, and
+    // check for blackjacks once the last card's animation is done
+    co_await delay(0);
     for (int i = 0; i < 2; ++i) {
-        // Deal Player Card
-        QTimer::singleShot(delay, this, [this]() {
-            dealPlayerCard(0, false);
-        });
-
-        delay += step;
-
-        // Deal Dealer Card
-        QTimer::singleShot(delay, this, &BlackjackGame::dealDealerCard);
-        delay += step;
-    }
-}
-
-void BlackjackGame::dealPlayerCard(int handIndex, bool isLastCard) {
-    Card c = drawCardFromShoe();
-
-    // Add Hi-Lo Count to running count
-    runningCount_ += c.getHiLoValue();
-
-    // Safety check in case game closed
-    if (playerHands_.isEmpty()) return;
-
-    playerHands_[handIndex].append(c);
-    emit playerCardDealt(c, handIndex, isLastCard);
-}
-
-void BlackjackGame::dealDealerCard() {
-    Card c = drawCardFromShoe();
-
-    dealerHand_.append(c);
-    emit dealerCardDealt(c);
-
-    if(dealerHand_.size() == 1) {
-        // Add Hi-Lo Count to running count
-        runningCount_ += c.getHiLoValue();
-    }
-
-    // If this is the last card (2nd round, dealer), check for BJ
-    if (dealerHand_.size() == 2) {
-        QTimer::singleShot(600, this, [this]() {
-            bool playerHasBJ = isBlackJack(playerHands_[0]);
-            bool dealerHasBJ = isBlackJack(dealerHand_);
+        engine_.dealPlayerCard(0, false);
+        co_await delay(DEAL_DELAY);
+        engine_.dealDealerCard();
+        co_await delay(i == 0 ? DEAL_DELAY : BLACKJACK_CHECK_DELAY);
+    }
+
+    if (engine_.checkForBlackjacks()) {
+        revealHoleCard();
+        checkCardsAndRound(0);
+        co_return;
+    }
+
+    // Player's turn: each action the player can make is played, and others are ignored.
+    // A hand is stood when the player stands or it can take no more cards.
+    emitPlayerTurn();
+    while (engine_.getPhase() == RoundEngine::Phase::PlayerTurn) {
+        PlayerAction action = co_await input_.next();
+        switch (action) {
+        case PlayerAction::Hit:
+            if (!engine_.hit()) continue;
+            log_.recordAction(SessionLog::EventType::Hit);
+            roundRecord_.addAction(PlayerAction::Hit);
+
+            // Stand automatically on a bust or 21
+            if (!engine_.isHandComplete(engine_.getCurrentHandIndex())) continue;
+            break;
+        case PlayerAction::Double:
+            if (!engine_.doubleDown()) continue;
+            log_.recordAction(SessionLog::EventType::Double);
+            roundRecord_.addAction(PlayerAction::Double);
 
-            if (playerHasBJ || dealerHasBJ) {
-                // Now that the animation is done, it is safe to flip the hole card
-                emit dealerTurnStarted();
-                checkCardsAndRound(0, determineWinner(playerHands_[0], dealerHand_, false));
-            }
-            else {
-                // Player's turn - check if double/split allowed
-                emit playerTurn(0, canDouble(), canSplit(), canSurrender());
+            // Wait a short delay before standing
+            co_await delay(AUTO_STAND_DELAY);
+            break;
+        case PlayerAction::Split:
+            if (!engine_.split()) continue;
+            log_.recordAction(SessionLog::EventType::Split);
+            roundRecord_.addAction(PlayerAction::Split);
+
+            if (!engine_.isHandComplete(engine_.getCurrentHandIndex())) {
+                // Normal split: play the first split hand
+                emitPlayerTurn();
+                continue;
             }
-        });
-    }
-}
-
-// Game logic.
+            // 21, or split aces that can't be hit: stand after a short delay
+            co_await delay(AUTO_STAND_DELAY);
+            break;
+        case PlayerAction::Surrender:
+            if (!engine_.canSurrender()) continue;
+            surrenderHand();
+            co_return;
+        case PlayerAction::Stand:
+            roundRecord_.addAction(PlayerAction::Stand);
+            break;
+        default:
+            continue;
+        }
 
-int BlackjackGame::getHandValue(QVector<Card>& hand) {
-    int value = 0;
-    int aceCount = 0;
+        log_.recordAction(SessionLog::EventType::Stand);
+        if (engine_.stand())
+            emitPlayerTurn();
+    }
 
-    for (const auto& card : hand) {
-        value += card.getBlackjackValue();
-        if (card.rank == Card::Rank::Ace) {
-            aceCount++;
+    // Dealer's turn: always reveal the hole card, but only draw if at least one player
+    // hand is alive, waiting for each card's animation
+    revealHoleCard();
+    if (!engine_.allHandsBusted()) {
+        while (engine_.dealerShouldHit()) {
+            engine_.dealerHit();
+            co_await delay(DEALER_HIT_DELAY);
         }
     }
 
-    // Account for aces
-    while (value > 21 && aceCount > 0) {
-        value -= 10; // Count ace as 1 instead of 11 to not bust.
-        aceCount--; // Player still has ace but it is locked as a 1 now.
+    // Settle each hand in turn, showing each result before the next. The UI handles the
+    // final reset.
+    for (int handIndex = 0; engine_.isRoundInProgress() && handIndex < engine_.getHandCount(); ++handIndex) {
+        if (handIndex > 0)
+            co_await delay(RESULT_DELAY);
+        checkCardsAndRound(handIndex);
     }
-
-    return value;
 }
 
-bool BlackjackGame::isBust(QVector<Card>& hand) {
-    return getHandValue(hand) > 21;
+ClockDelay BlackjackGame::delay(int milliseconds) const {
+    return ClockDelay(*clock_, milliseconds);
 }
 
-bool BlackjackGame::isBlackJack(const QVector<Card>& hand) {
-    return hand.size() == 2 && getHandValue(const_cast<QVector<Card>&>(hand)) == 21;
+void BlackjackGame::onPlayerCardDealt(Card card, int handIndex, bool isLastCard) {
+    counts_.observe(card);
+    emit playerCardDealt(card, handIndex, isLastCard);
 }
 
-bool BlackjackGame::is21(const QVector<Card> &hand) {
-    return getHandValue(const_cast<QVector<Card>&>(hand)) == 21;
+void BlackjackGame::onDealerCardDealt(Card card) {
+    // The hole card is counted when it is revealed
+    if (engine_.getDealerHand().size() != 2)
+        counts_.observe(card);
+    emit dealerCardDealt(card);
 }
 
-bool BlackjackGame::isSoftHand(const QVector<Card>& hand) {
-    int value = 0;
-    bool hasAce = false;
-
-    for (const auto& card : hand) {
-        value += card.getBlackjackValue();
-        if (card.rank == Card::Rank::Ace) {
-            hasAce = true;
-        }
-    }
-
-    return hasAce && value <= 21;
+void BlackjackGame::revealHoleCard() {
+    counts_.observe(engine_.getDealerHand().cards()[1]);
+    emit dealerTurnStarted();
 }
 
-bool BlackjackGame::canDouble() const {
-    return playerHands_[currentHandIndex_].size() == 2 && (rules_.doubleAfterSplit || playerHands_.size() == 1)
-        && balance_ >= betAmounts_[currentHandIndex_];
+void BlackjackGame::onCutCardDrawn() {
+    emit cutCardDrawn();
 }
 
-bool BlackjackGame::canSurrender() const {
-    // Surrender must be allowed in rules
-    if (!rules_.surrenderAllowed) return false;
-
-    if (!hasRoundStarted_) return false;
-
-    // Only allow on the initial hand, before any split
-    if (playerHands_.size() != 1) return false;
-    if (currentHandIndex_ != 0) return false;
-
-    // Only when this hand has exactly two cards (no hits yet)
-    if (playerHands_[0].size() != 2) return false;
-
-    return true;
+void BlackjackGame::onBetPlaced(int amount) {
+    emit betPlaced(amount);
 }
 
-bool BlackjackGame::canSplit() const {
-    if (playerHands_[currentHandIndex_].size() != 2) {
-        return false;
-    }
-    if (playerHands_[currentHandIndex_][0].getBlackjackValue() !=
-        playerHands_[currentHandIndex_][1].getBlackjackValue()) {
-        return false;
-    }
-    if (playerHands_.size() > 1) {
-        if (!rules_.resplit)
-            return false;
-        if (playerHands_[currentHandIndex_][0].rank == Card::Rank::Ace && !rules_.resplitAces)
-            return false;
-    }
-    if (balance_ < betAmounts_[currentHandIndex_]) {
-        return false;
-    }
-    return true;
+void BlackjackGame::onHandSplit(int handIndex) {
+    emit splitHand(handIndex);
 }
 
-BlackjackGame::GameResult BlackjackGame::determineWinner(QVector<Card>& playerHand, QVector<Card>& dealerHand, bool isSplitHand) {
-    int playerValue = getHandValue(playerHand);
-    int dealerValue = getHandValue(dealerHand);
-
-    // Check Busts
-    if (playerValue > 21) {
-        return GameResult::Lose;
-    }
-    if (dealerValue > 21) {
-        return GameResult::Win;
-    }
-
-    // Check Blackjacks - only count as blackjack if not from a split
-    bool pBJ = !isSplitHand && isBlackJack(playerHand);
-    bool dBJ = isBlackJack(dealerHand);
-
-    if (pBJ && !dBJ) {
-        return GameResult::Blackjack;
-    }
-    if (dBJ && !pBJ) {
-        return GameResult::Lose;
-    }
-    if (pBJ && dBJ) {
-        return GameResult::Push;
-    }
-
-    // Compare Values
-    if (playerValue > dealerValue) {
-        return GameResult::Win;
-    }
-    if (playerValue < dealerValue) {
-        return GameResult::Lose;
-    }
-
-    // Otherwise a push
-    return GameResult::Push;
-}
-
-// Game logic methods.
-
-bool BlackjackGame::dealerShouldHit(QVector<Card>& hand) const {
-    int value = getHandValue(hand);
-    if (value < 17) {
-        return true;
-    }
-    if (value == 17 && rules_.dealerHitsSoft17 && isSoftHand(hand)) {
-        return true;
-    }
-    return false;
+void BlackjackGame::emitPlayerTurn() {
+    emit playerTurn(engine_.getCurrentHandIndex(), engine_.canDouble(), engine_.canSplit(),
+                    engine_.canSurrender());
 }
 
-void BlackjackGame::dealerTurn() {
-    emit dealerTurnStarted();  // Always reveal hole card
+// Game logic.
 
-    // Only continue drawing if at least one player hand is alive
-    if (allHandsBusted()) {
-        dealerStand();
-    }
-    else {
-        continueDealerTurn();
-    }
+int BlackjackGame::getHandValue(const QVector<Card>& hand) {
+    return RoundEngine::getHandValue(hand);
 }
 
-void BlackjackGame::continueDealerTurn() {
-    if (dealerShouldHit(dealerHand_)) {
-        dealerHit();
-        // Wait for animation delay before continuing
-        QTimer::singleShot(1000, this, &BlackjackGame::continueDealerTurn);
-    }
-    else {
-        dealerStand();
-    }
+bool BlackjackGame::isBust(const QVector<Card>& hand) {
+    return RoundEngine::isBust(hand);
 }
 
-void BlackjackGame::dealerHit() {
-    Card c = drawCardFromShoe();
-    dealerHand_.append(c);
-    emit dealerCardDealt(c);
+bool BlackjackGame::isBlackJack(const QVector<Card>& hand) {
+    return RoundEngine::isBlackJack(hand);
 }
 
-void BlackjackGame::dealerStand() {
-    resultHandIndex_ = 0;  // Start with first hand
-    processNextHandResult();
+bool BlackjackGame::is21(const QVector<Card> &hand) {
+    return RoundEngine::is21(hand);
 }
 
-void BlackjackGame::processNextHandResult() {
-    // Check if there are more hands to process
-    if (resultHandIndex_ < playerHands_.size()) {
-        // Determine result for current hand
-        bool isSplitHand = playerHands_.size() > 1;
-        GameResult result = determineWinner(playerHands_[resultHandIndex_], dealerHand_, isSplitHand);
-
-        // Calculate payout
-        int payout = 0;
-        switch (result) {
-        case GameResult::Win:
-            payout = betAmounts_[resultHandIndex_] * 2;
-            break;
-        case GameResult::Push:
-            payout = betAmounts_[resultHandIndex_];
-            break;
-        case GameResult::Blackjack:
-            payout = static_cast<int>(betAmounts_[resultHandIndex_] * (1 + rules_.blackjackPayout));
-            break;
-        default:
-            // Lose: payout = 0
-            break;
-        }
-
-
-        balance_ += payout;
-        emit roundEnded(result, payout, resultHandIndex_, playerHands_.size());
-
-        // Move to next hand
-        resultHandIndex_++;
-
-        // Schedule processing of next hand after delay (2 seconds)
-        QTimer::singleShot(2000, this, &BlackjackGame::processNextHandResult);
-    }
-    else {
-        hasRoundStarted_ = false;
-    }
-    // All hands processed - UI will handle final reset
+bool BlackjackGame::isSoftHand(const QVector<Card>& hand) {
+    return RoundEngine::isSoftHand(hand);
 }
 
 bool BlackjackGame::isHandBust(QVector<Card> hand) const {
@@ -331,205 +233,109 @@ int BlackjackGame::playerHandValue(QVector<Card> hand) const {
     return getHandValue(hand);
 }
 
-// Player Actions
+// Player Actions. Each is handed to the round, if it is waiting for one.
 
 void BlackjackGame::playerHit() {
-    if (currentHandIndex_ >= playerHands_.size()) return;
-
-    dealPlayerCard(currentHandIndex_, false);
-
-    if (isBust(playerHands_[currentHandIndex_])) {
-        playerStand();
-        return;
-    }
-
-    int value = getHandValue(playerHands_[currentHandIndex_]);
-
-    if (value == 21) {
-        playerStand();
-        return;
-    }
+    input_.submit(BasicStrategyChecker::PlayerAction::Hit);
 }
 
 void BlackjackGame::playerDouble() {
-    if (currentHandIndex_ >= playerHands_.size()) return;
-    if (!canDouble()) return;
-
-    dealPlayerCard(currentHandIndex_, true);
-    balance_ -= betAmounts_[currentHandIndex_];
-    emit betPlaced(betAmounts_[currentHandIndex_]);
-    betAmounts_[currentHandIndex_] *= 2;
-
-    // Wait a short delay before the dealer's turn
-    QTimer::singleShot(500, this, &BlackjackGame::playerStand);
+    input_.submit(BasicStrategyChecker::PlayerAction::Double);
 }
 
-int BlackjackGame::getRunningCount() {
-    return runningCount_;
+double BlackjackGame::getRunningCount() const {
+    return counts_.getRunningCount(getCountingSystem());
 }
 
-float BlackjackGame::getTrueCount(){
-    return (float)runningCount_ * 52 / (shoe_->getSize() - 1); // Need to subtract 1 to account for cut card
+float BlackjackGame::getTrueCount() const {
+    return static_cast<float>(getTrueCount(getCountingSystem()));
 }
 
-void BlackjackGame::playerSurrender() {
-    // If surrender is not allowed at this moment, ignore the action.
-    if (!canSurrender()) return;
+double BlackjackGame::getTrueCount(CountingSystem::Id system) const {
+    return counts_.getTrueCount(system, engine_.getShoe().getDecksRemaining());
+}
 
-    int handIndex = currentHandIndex_;
-    int bet = betAmounts_[handIndex];
+CountingSystem::Id BlackjackGame::getCountingSystem() const {
+    return engine_.getRuleset().countingSystem;
+}
 
-    // Late surrender: player gets half the bet back, loses the hand.
-    int refund = bet / 2;
+const CountTracker& BlackjackGame::getCountTracker() const {
+    return counts_;
+}
 
-    balance_ += refund;
+void BlackjackGame::playerSurrender() {
+    input_.submit(BasicStrategyChecker::PlayerAction::Surrender);
+}
 
-    hasRoundStarted_ = false;
+void BlackjackGame::surrenderHand() {
+    int handIndex = engine_.getCurrentHandIndex();
+    RoundEngine::HandOutcome outcome = engine_.surrender();
+    log_.recordAction(SessionLog::EventType::Surrender);
+    log_.recordOutcome(outcome, engine_.getBalance());
+    roundRecord_.addAction(BasicStrategyChecker::PlayerAction::Surrender);
 
-    emit roundEnded(GameResult::Surrender, refund, handIndex, playerHands_.size());
+    emit roundEnded(outcome.result, outcome.payout, handIndex, engine_.getHandCount());
+    recordRound();
 }
 
 void BlackjackGame::playerStand() {
-    int nextHand = findNextPlayableHand(currentHandIndex_ + 1);
-    if (nextHand != -1) {
-        currentHandIndex_ = nextHand;
-        emit playerTurn(currentHandIndex_, canDouble(), canSplit(), canSurrender());
-    }
-    else {
-        dealerTurn();
-    }
+    input_.submit(BasicStrategyChecker::PlayerAction::Stand);
 }
 
 void BlackjackGame::playerSplit() {
-    if (!canSplit()) return;
-
-    // Update player hands
-    Card splitCard = playerHands_[currentHandIndex_].takeLast();
-    QVector<Card> newHand;
-    newHand.append(splitCard);
-    playerHands_.insert(currentHandIndex_ + 1, newHand);
-
-    // Update bet amounts
-    betAmounts_.insert(currentHandIndex_ + 1, betAmounts_[currentHandIndex_]);
-    balance_ -= betAmounts_[currentHandIndex_];
-    emit betPlaced(betAmounts_[currentHandIndex_]);
-
-    // New cards should be last cards of their hands if splitting aces and
-    // rules declare no hitting after splitting aces
-    bool isLastCard = splitCard.rank == Card::Rank::Ace && !rules_.hitSplitAces;
-
-    emit splitHand(currentHandIndex_);
-
-    // Deal new cards
-    dealPlayerCard(currentHandIndex_, isLastCard);
-    dealPlayerCard(currentHandIndex_ + 1, isLastCard);
-
-    if (is21(playerHands_[currentHandIndex_])) {
-        QTimer::singleShot(500, this, &BlackjackGame::playerStand);
-    } else if (isLastCard) {
-        // Stand after a short delay
-        QTimer::singleShot(500, this, &BlackjackGame::playerStand);
-    } else {
-        // Normal split: emit playerTurn for the first split hand
-        emit playerTurn(currentHandIndex_, canDouble(), canSplit(), canSurrender());
-    }
+    input_.submit(BasicStrategyChecker::PlayerAction::Split);
 }
 
 // Results
 
-void BlackjackGame::checkCardsAndRound(int handIndex, GameResult currentState) {
-    int payout = 0;
-    switch (currentState) {
-    case GameResult::Win:
-        // Give player back the money they bet and the money they made
-        payout = betAmounts_[handIndex] * 2;
-        break;
-    case GameResult::Push:
-        // Give player back the money they bet
-        payout = betAmounts_[handIndex];
-        break;
-    case GameResult::Blackjack:
-        // Give back bet amount, then give payout based on ruleset
-        payout = static_cast<int>(betAmounts_[handIndex] * (1 + rules_.blackjackPayout));
-        break;
-    default:
-        // If player loses, pay nothing
-        break;
-    }
-    balance_ += payout;
-    emit roundEnded(currentState, payout, handIndex, playerHands_.size());
+void BlackjackGame::checkCardsAndRound(int handIndex) {
+    RoundEngine::HandOutcome outcome = engine_.settleHand(handIndex);
+    log_.recordOutcome(outcome, engine_.getBalance());
+    emit roundEnded(outcome.result, outcome.payout, handIndex, engine_.getHandCount());
+    if (!engine_.isRoundInProgress())
+        recordRound();
+}
 
-    hasRoundStarted_ = false;
+void BlackjackGame::recordRound() {
+    roundRecord_.setRound(engine_, QDateTime::currentMSecsSinceEpoch());
+    emit roundRecorded(roundRecord_);
 }
 
 Card BlackjackGame::drawCardFromShoe() {
-    Card c = shoe_->draw();
-    if (c.rank == Card::Rank::Cut) {
-        needsShuffling_ = true;
-        emit cutCardDrawn();
-        c = shoe_->draw();
-    }
-    return c;
+    log_.recordDraw();
+    return engine_.drawCard();
 }
 
-bool BlackjackGame::allHandsBusted() const {
-    for (const auto& hand : playerHands_) {
-        if (!isBust(const_cast<QVector<Card>&>(hand))) {
-            return false;
-        }
+BasicStrategyChecker::PlayerAction BlackjackGame::getBestMove() const {
+    // The index plays are Hi-Lo indices, whichever count the player is practicing
+    if (engine_.getRuleset().indexPlays) {
+        return engine_.getBestMove(deviations_, static_cast<int>(std::floor(getTrueCount(CountingSystem::Id::HiLo))));
     }
-    return true;
+    return engine_.getBestMove(strategyChecker_);
 }
 
-BasicStrategyChecker::PlayerAction BlackjackGame::getBestMove() const {
-    BasicStrategyChecker::PlayerAction bestMove = strategyChecker_.getBestMove(playerHands_[currentHandIndex_], dealerHand_[0]);
-    if (!canMakeAction(bestMove)) {
-        BasicStrategyChecker::PlayerAction secondBestMove = strategyChecker_.getSecondBestMove(playerHands_[currentHandIndex_], dealerHand_[0]);
-        if (!canMakeAction(secondBestMove))
-            return strategyChecker_.getThirdBestMove(playerHands_[currentHandIndex_], dealerHand_[0]);
-        return secondBestMove;
-    }
-    return bestMove;
-}
-
-bool BlackjackGame::canMakeAction(BasicStrategyChecker::PlayerAction action) const {
-    switch (action) {
-    case BasicStrategyChecker::PlayerAction::Split:
-        return canSplit();
-    case BasicStrategyChecker::PlayerAction::SplitIfDas:
-        return rules_.doubleAfterSplit && canSplit();
-    case BasicStrategyChecker::PlayerAction::Double:
-        return canDouble();
-    case BasicStrategyChecker::PlayerAction::Surrender:
-        return canSurrender();
-    default:
-        return true;
-    }
+ExpectedValueCalculator::ActionValues BlackjackGame::getActionValues() const {
+    return engine_.getActionValues(evCalculator_);
 }
 
-bool BlackjackGame::dealerHitsSoft17() const {
-    return rules_.dealerHitsSoft17;
-}
-
-int BlackjackGame::findNextPlayableHand(int startIndex) const {
-    for (int i = startIndex; i < playerHands_.size(); ++i) {
-        const QVector<Card>& hand = playerHands_[i];  // ← Explicit const ref
-        if (!BlackjackGame::isBust(const_cast<QVector<Card>&>(hand)) &&
-            BlackjackGame::getHandValue(const_cast<QVector<Card>&>(hand)) < 21 &&
-            !(BlackjackGame::getHandValue(const_cast<QVector<Card>&>(hand)) == 21 &&
-              !rules_.hitSplitAces &&
-              playerHands_[i][0].rank == Card::Rank::Ace)) {
-            return i;
-        }
-    }
-    return -1;  // No playable hands found
+void BlackjackGame::seedShoe(quint64 seed) {
+    engine_.seedShoe(seed);
+    counts_.reset(engine_.getRuleset().numDecks);
+    log_ = SessionLog(seed, engine_.getRuleset(), engine_.getBalance());
 }
 
+const SessionLog& BlackjackGame::getSessionLog() const {
+    return log_;
+}
+
+bool BlackjackGame::dealerHitsSoft17() const {
+    return engine_.getRuleset().dealerHitsSoft17;
+}
 
 const QVector<Card>& BlackjackGame::getCurrentHand() const {
-    return playerHands_[currentHandIndex_];
+    return engine_.getCurrentHand().cards();
 }
 
 Card BlackjackGame::getDealerUpcard() const {
-    return dealerHand_[0];
+    return engine_.getDealerUpcard();
 }
@@ -2,37 +2,81 @@
 #define BLACKJACK_GAME_H
 
 #include "card.h"
+#include "counting_system.h"
 #include "ruleset.h"
 #include "shoe.h"
 #include "basic_strategy_checker.h"
+#include "deviation_table.h"
+#include "game_clock.h"
+#include "hand_history.h"
+#include "round_engine.h"
+#include "round_task.h"
+#include "session_log.h"
 #include <QObject>
-#include <QTimer>
 
-class BlackjackGame : public QObject {
+/// @brief Plays blackjack rounds at animation speed. All of the game rules live in the
+/// RoundEngine; this class steps through the engine with delays between cards and results,
+/// and emits signals for the UI as the engine deals. Each round is a single coroutine,
+/// playRound, that awaits every delay on a GameClock and every player action, so the flow
+/// can be sped up, or run instantly by a VirtualClock, without changing its order.
+class BlackjackGame : public QObject, private RoundEngine::Observer {
     Q_OBJECT
 
 public:
-    /// @brief
-    explicit BlackjackGame(QObject *parent = nullptr);
+    /// @brief The delay between the cards of the initial deal, in milliseconds.
+    static constexpr int DEAL_DELAY = 500;
+
+    /// @brief The delay after the initial deal before checking for blackjacks, in
+    /// milliseconds, so the last card's animation finishes first.
+    static constexpr int BLACKJACK_CHECK_DELAY = 600;
+
+    /// @brief The delay between the dealer's hits, in milliseconds.
+    static constexpr int DEALER_HIT_DELAY = 1000;
+
+    /// @brief The delay before a hand that can take no more cards (after a double or
+    /// splitting aces) is stood, in milliseconds.
+    static constexpr int AUTO_STAND_DELAY = 500;
+
+    /// @brief The time each hand's result is shown before the next, in milliseconds.
+    static constexpr int RESULT_DELAY = 2000;
+
+    /// @brief Creates a new BlackjackGame.
+    /// @param parent The parent object.
+    /// @param clock The clock the game's delays are scheduled on, which must outlive the
+    /// game. If null, the shared real-time clock is used.
+    explicit BlackjackGame(QObject *parent = nullptr, GameClock* clock = nullptr);
+
+    /// @brief Gets the clock the game's delays are scheduled on, which the UI uses for its
+    /// own game-flow delays so both run at the same speed.
+    GameClock& getClock() const;
 
     /// @brief defines an enum for the different possible results of a hand.
-    enum class GameResult {
-        Win,
-        Lose,
-        Push,
-        Blackjack,
-        Surrender
-    };
-
-    /// @brief Change the ruleset of the game.
+    using GameResult = RoundEngine::GameResult;
+
+    /// @brief Change the ruleset of the game. The basic strategy for the new rules is
+    /// loaded from the strategy cache, or solved (which takes a few seconds) and cached if
+    /// these rules have not been used before, on a worker thread. Until it is ready,
+    /// hints come from the compile-time table closest to the rules.
     /// @param rules The new ruleset.
     void setRuleset(Ruleset rules);
 
-    /// @brief Gets the running count for the game.
-    int getRunningCount();
+    /// @brief Gets the running count of the ruleset's counting system, over every card
+    /// the player has seen since the shoe was shuffled.
+    double getRunningCount() const;
+
+    /// @brief Gets the true count of the ruleset's counting system.
+    float getTrueCount() const;
+
+    /// @brief Gets the true count of a counting system, whichever system the player is
+    /// practicing.
+    /// @param system The counting system.
+    double getTrueCount(CountingSystem::Id system) const;
 
-    /// @brief Gets the true count for the game.
-    float getTrueCount();
+    /// @brief Gets the counting system the player is practicing, from the ruleset.
+    CountingSystem::Id getCountingSystem() const;
+
+    /// @brief Gets the running count of every counting system.
+    const CountTracker& getCountTracker() const;
 
     /// @brief Setter for the needsShuffling_ bool.
     void setShuffling(bool needsShuffling);
@@ -60,14 +104,29 @@ public:
     /// getter method for the hand value.
     int playerHandValue(QVector<Card> hand) const;
 
-    /// @brief Finds the best move for the given hand, dealer upcard, and ruleset.
+    /// @brief Finds the best move for the given hand, dealer upcard, and ruleset. If the
+    /// ruleset enables index plays, the move is adjusted for the current true count.
     /// @return One of Hit, Double, Stand, Split, or Surrender, depending on which
     /// is the most optimal for the current ruleset, hand, and dealer upcard.
     BasicStrategyChecker::PlayerAction getBestMove() const;
 
+    /// @brief Computes the exact expected value of each action for the current hand,
+    /// using the cards that have not been seen yet in the shoe.
+    /// @return The expected value of each action, in units of the hand's bet.
+    ExpectedValueCalculator::ActionValues getActionValues() const;
+
+    /// @brief Gets the record of this game so far, from which it can be replayed exactly.
+    const SessionLog& getSessionLog() const;
+
+    /// @brief Starts a fresh shoe shuffled from a seed, and a new session log from it, so
+    /// the game deals the same cards for the same seed. A new game is seeded at random.
+    /// Must be called between rounds.
+    /// @param seed The seed for the shoe.
+    void seedShoe(quint64 seed);
+
 public slots:
     /// @brief Signals that the player's balance has changed, then starts a new
-    /// round.
+    /// round. A round still in progress is abandoned.
     void beginRound(int betAmount);
 
     /// @brief Player hits to draw another card.
@@ -126,87 +185,52 @@ signals:
     /// @param amount The total amount of the bet the player has placed.
     void betPlaced(int amount);
 
-private slots:
-    /// @brief Recursive helper for dealer's turn (called by QTimer).
-    void continueDealerTurn();
-
-    /// @brief Processes the next hand's result with appropriate delay.
-    void processNextHandResult();
+    /// @brief Emitted once every hand of a round has been settled, with the round's
+    /// record for the hand history.
+    /// @param record The cards, actions, bets, and results of the round.
+    void roundRecorded(const HandHistoryRecord& record);
 
 private:
-    /// @brief Resets state and calls dealCards().
-    void dealNewHand();
+    /// @brief Plays a round from the bet to the last result: the initial deal, the
+    /// player's actions, the dealer's turn, and settling each hand, waiting on the clock
+    /// between steps so the UI can animate them.
+    /// @param betAmount The initial bet.
+    RoundTask playRound(int betAmount);
 
-    /// @brief Handles the initial deal animation with timers.
-    void dealCards();
+    /// @brief Makes the round wait on the clock.
+    /// @param milliseconds The delay, in milliseconds of game time.
+    ClockDelay delay(int milliseconds) const;
 
-    /// @brief Deals a card to the dealer.
-    void dealDealerCard();
+    /// @brief Loads or solves the basic strategy for a ruleset on a worker thread, and
+    /// swaps it in when it is ready, unless the ruleset has changed again by then.
+    void solveStrategy(const Ruleset& rules);
 
-    /// @brief Deals a card to the player.
-    /// @param handIndex The index of the hand to deal to.
-    /// @param isLastDeal Indicates whether the card to be dealt will be the
-    /// last card dealt for the hand (i.e. if the player doubled or split aces)
-    /// and should be dealt sideways.
-    void dealPlayerCard(int handIndex, bool isLastDeal);
+    /// @brief Surrenders the current hand, ending the round.
+    void surrenderHand();
 
     /// @brief Helper to resolve the round and emit roundEnded.
-    void checkCardsAndRound(int handIndex, GameResult currentState);
+    void checkCardsAndRound(int handIndex);
 
-    /// @brief determines the winner of the hand.
-    /// @param playerHand vector holding player's hand.
-    /// @param dealerHand vector holding dealer's hand.
-    /// @param isSplitHand true if this hand came from a split.
-    /// @return game result.
-    static GameResult determineWinner(QVector<Card>& playerHand, QVector<Card>& dealerHand, bool isSplitHand = false);
+    /// @brief Emits playerTurn for the engine's current hand.
+    void emitPlayerTurn();
 
-    /// @brief Inidicates dealer turn.
-    void dealerTurn();
+    /// @brief Completes the round's hand-history record and emits roundRecorded.
+    void recordRound();
 
-    /// @brief Determines if the player can double based on their current active
-    /// hand and the ruleset.
-    /// @return true if player can double, false otherwise.
-    bool canDouble() const;
+    /// @brief Updates the count and emits playerCardDealt when the engine deals to the player.
+    void onPlayerCardDealt(Card card, int handIndex, bool isLastCard) override;
 
-    /// @brief determines if the player can surrender.
-    /// @param hand vector holding the cards.
-    /// @return true if player can surrender.
-    bool canSurrender() const;
-
-    /// @brief determines if the player can split.
-    /// @return true if player can split.
-    bool canSplit() const;
+    /// @brief Updates the count and emits dealerCardDealt when the engine deals to the dealer.
+    void onDealerCardDealt(Card card) override;
 
-    // Dealer methods
-    /// @brief Dealer hits to draw another card.
-    void dealerHit();
+    /// @brief Emits cutCardDrawn when the engine draws the cut card.
+    void onCutCardDrawn() override;
 
-    /// @brief Dealer stands, round/deal ends.
-    void dealerStand();
+    /// @brief Emits betPlaced when the engine takes a bet.
+    void onBetPlaced(int amount) override;
 
-    /// @brief determines if the dealer should hit.
-    /// @param hand vector holding the cards.
-    /// @return true if dealer should hit.
-    bool dealerShouldHit(QVector<Card>& hand) const;
-
-    /// @brief Checks if all player hands are busted.
-    /// @return true if all hands are busted, false otherwise.
-    bool allHandsBusted() const;
-
-    /// @brief Returns true if the player can play the given action with the current
-    /// hand and ruleset. Otherwise, returns false. In the case where action is
-    /// BasicStrategyChecker::PlayerAction::SplitIfDas, but double after split (DAS)
-    /// is not allowed, returns false.
-    /// @param action The action to check for playability.
-    /// @returns A bool indicating whether the player is able to play (and should play)
-    /// the given action.
-    bool canMakeAction(BasicStrategyChecker::PlayerAction action) const;
-
-    /// @brief Looks for the next playable hand so that it can correctly be transmitted
-    /// to the visuals.
-    /// @param startIndex The passed in original index from which to start looking.
-    /// @return The index of the next playable hand, -1 if none found.
-    int findNextPlayableHand(int startIndex) const;
+    /// @brief Emits splitHand when the engine splits a hand.
+    void onHandSplit(int handIndex) override;
 
 public:
     // Static game state methods.
@@ -214,13 +238,13 @@ public:
     /// Handles logic of ace being 1 or 11.
     /// @param hand vector holding the cards.
     /// @return reports aces as 11 unless that results in a bust.
-    static int getHandValue(QVector<Card>& hand);
+    static int getHandValue(const QVector<Card>& hand);
 
     /// @brief determines if the current hand is a.
     /// @param hand vector holding the cards.
     /// @param hand vector holding the cards.
     /// @return true if the hand is a bust
-    static bool isBust(QVector<Card>& hand);
+    static bool isBust(const QVector<Card>& hand);
 
     /// @brief determines if the current hand is a blackjack.
     /// @param hand vector holding the cards.
@@ -240,44 +264,43 @@ public:
 private:
 
     // Member variables.
-    /// @brief Holds the ruleset.
-    Ruleset rules_;
+    /// @brief Schedules the delays between the steps of a round.
+    GameClock* clock_;
 
-    /// @brief The shoe of the blackjack game.
-    Shoe* shoe_;
+    /// @brief Holds the rules of the game, the shoe, and the state of the current round.
+    RoundEngine engine_;
 
-    /// @brief The amount of money the player has.
-    int balance_;
+    /// @brief Counts the hole card and emits dealerTurnStarted, which reveals it.
+    void revealHoleCard();
 
-    /// @brief The current bet amount for the round.
-    int currentBetAmount_;
+    /// @brief Counts every card the player has seen since the shoe was shuffled, in
+    /// every counting system.
+    CountTracker counts_;
 
-    /// @brief Holds the player's current hands.
-    QVector<QVector<Card>> playerHands_;
-
-    /// @brief Holds the bet amounts for each of the player's hands.
-    QVector<int> betAmounts_;
+    /// @brief Allows for finding the best move in a given scenario.
+    BasicStrategyChecker strategyChecker_;
 
-    /// @brief Holds the dealer's current hand.
-    QVector<Card> dealerHand_;
+    /// @brief The index plays used for hints when the ruleset enables them.
+    DeviationTable deviations_;
 
-    /// @brief True if the shoe needs shuffling. False otherwise.
-    bool needsShuffling_;
+    /// @brief Counts the strategy solves started, so a solve finishing after the ruleset
+    /// has changed again is ignored.
+    quint64 strategyGeneration_;
 
-    /// @brief True if the current round/deal has started. False otherwise.
-    bool hasRoundStarted_;
+    /// @brief Computes the exact expected value of each action for the current shoe.
+    ExpectedValueCalculator evCalculator_;
 
-    /// @brief Tracks which hand is currently active to account for split hands.
-    int currentHandIndex_;
+    /// @brief Records the seed, bets, and actions of the game for replaying.
+    SessionLog log_;
 
-    /// @brief Index of hand currently being processed for result display.
-    int resultHandIndex_;
+    /// @brief The hand-history record of the current round, filled in as it is played.
+    HandHistoryRecord roundRecord_;
 
-    /// @brief Holds the running count of all the cards dealt
-    int runningCount_;
+    /// @brief Hands the player's actions to the round.
+    PlayerInput input_;
 
-    /// @brief Allows for finding the best move in a given scenario.
-    BasicStrategyChecker strategyChecker_;
+    /// @brief The current round, waiting for a delay or an action, or finished.
+    RoundTask round_;
 };
 
 #endif // BLACKJACK_GAME_H
@@ -1,11 +1,16 @@
 #ifndef CARD_H
 #define CARD_H
 
+#include <cstdint>
+
+/// @brief A playing card, packed into a single byte: the rank is stored in the low four
+/// bits and the suit in the high four bits. Values that depend only on the rank are read
+/// from constexpr tables rather than computed, so none of the getters branch.
 struct Card {
 public:
     /// @brief The possible suits for a playing card. "Cut" represents the cut card,
     /// which tells the dealer when to shuffle the shoe.
-    enum class Suit {
+    enum class Suit : std::uint8_t {
         Spades,
         Hearts,
         Clubs,
@@ -15,7 +20,7 @@ public:
 
     /// @brief The possible ranks for a playing card. "Cut" describes the cut card,
     /// which tells the dealer when to shuffle the shoe.
-    enum class Rank {
+    enum class Rank : std::uint8_t {
         Cut,
         Ace,
         Two,
@@ -32,30 +37,86 @@ public:
         King
     };
 
+    /// @brief The number of ranks, including the cut card.
+    static constexpr int RANK_COUNT = 14;
+
+    /// @brief The blackjack value of each rank, indexed by rank. Aces are valued 11.
+    static constexpr std::int8_t BLACKJACK_VALUES[RANK_COUNT] {
+        0, 11, 2, 3, 4, 5, 6, 7, 8, 9, 10, 10, 10, 10
+    };
+
+    /// @brief The Hi-Lo counting tag of each rank, indexed by rank.
+    static constexpr std::int8_t HI_LO_VALUES[RANK_COUNT] {
+        0, -1, 1, 1, 1, 1, 1, 0, 0, 0, -1, -1, -1, -1
+    };
+
+    /// @brief The column of each rank in the card sprite sheet, indexed by rank. The cut
+    /// card is in the last column.
+    static constexpr std::uint8_t SPRITE_COLUMNS[RANK_COUNT] {
+        13, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12
+    };
+
+    /// @brief The row of each suit in the card sprite sheet, indexed by suit. The cut card
+    /// shares the hearts row.
+    static constexpr std::uint8_t SPRITE_ROWS[5] {
+        3, 2, 0, 1, 2
+    };
+
     // Code style note: the rank and suit members are not marked with a trailing underscore
     // because they are public.
 
     /// @brief The card's rank.
-    Rank rank;
+    Rank rank : 4;
 
     /// @brief The card's suit.
-    Suit suit;
+    Suit suit : 4;
 
     /// @brief Creates a new Card object.
     /// @param rank The rank of the card.
     /// @param suit The suit of the card.
-    explicit Card(Rank rank, Suit suit);
+    constexpr explicit Card(Rank rank, Suit suit)
+        : rank(rank), suit(suit)
+    {}
 
     /// @brief Gets the value of this card.
     /// @return the value of this card. Most cards are valued the same as their rank.
     /// Face cards are valued 10. Aces are valued either 1 or 11, but this method will
     /// return 11 if the card is an ace.
-    int getBlackjackValue() const;
+    constexpr int getBlackjackValue() const {
+        return BLACKJACK_VALUES[static_cast<int>(rank)];
+    }
 
     /// @brief Gets the value of this card according to the Hi-Lo card counting system.
     /// @return 1 if this card's rank is 2-6, -1 if this card's rank is jack-ace, or 0
     /// otherwise.
-    int getHiLoValue() const;
+    constexpr int getHiLoValue() const {
+        return HI_LO_VALUES[static_cast<int>(rank)];
+    }
+
+    /// @brief Gets the column of this card in the card sprite sheet.
+    constexpr int getSpriteColumn() const {
+        return SPRITE_COLUMNS[static_cast<int>(rank)];
+    }
+
+    /// @brief Gets the row of this card in the card sprite sheet.
+    constexpr int getSpriteRow() const {
+        return SPRITE_ROWS[static_cast<int>(suit)];
+    }
+
+    /// @brief Gets the one-byte encoding of this card.
+    /// @return The rank in the low four bits and the suit in the high four bits.
+    constexpr std::uint8_t pack() const {
+        return static_cast<std::uint8_t>(static_cast<int>(rank) | (static_cast<int>(suit) << 4));
+    }
+
+    /// @brief Creates a card from its one-byte encoding.
+    /// @param packed A value returned by pack.
+    /// @return The card that was packed.
+    static constexpr Card unpack(std::uint8_t packed) {
+        return Card(static_cast<Rank>(packed & 0x0F), static_cast<Suit>(packed >> 4));
+    }
 };
 
+static_assert(sizeof(Card) == 1, "Card should pack into a single byte");
+
 #endif // CARD_H
@@ -1,11 +1,13 @@
 #include "cards_view.h"
 #include <QResizeEvent>
+#include "game_clock.h"
 
 CardsView::CardsView(QWidget* parent)
     : QWidget(parent), cardSprites_(":/images/cards.png", 1.0),
-    deckItem_(nullptr), cutCardItem_(nullptr), currentHandIndex_(0),
+    deckItem_(nullptr), cutCardItem_(nullptr), handSelectionItem_(nullptr), currentHandIndex_(0),
     hasSplit_(false), holeCardItem_(nullptr), // Card doesn't matter
-    holeCard_(Card::Rank::Cut, Card::Suit::Cut), cardScale_(1.0) {
+    holeCard_(Card::Rank::Cut, Card::Suit::Cut), holeCardDealt_(false), holeCardFlipPending_(false),
+    clock_(nullptr), cardScale_(1.0) {
     // Create internal graphics view and scene
     view_ = new QGraphicsView(this);
     scene_ = new QGraphicsScene(this);
@@ -41,6 +43,10 @@ CardsView::CardsView(QWidget* parent)
     }
 }
 
+int CardsView::scaled(int duration) const {
+    return clock_ ? clock_->scale(duration) : duration;
+}
+
 int CardsView::getDealerHandY() const {
     return static_cast<int>(scene_->sceneRect().height() * DEALER_Y_PERCENT);
 }
@@ -237,7 +243,7 @@ void CardsView::repositionHandCards(int handIndex, int duration) {
             if (currentPos == newPos) continue;
 
             QVariantAnimation* reposition = new QVariantAnimation(this);
-            reposition->setDuration(duration);
+            reposition->setDuration(scaled(duration));
             reposition->setStartValue(currentPos);
             reposition->setEndValue(newPos);
             reposition->setEasingCurve(QEasingCurve::InOutQuad);
@@ -281,7 +287,7 @@ void CardsView::repositionHandCards(int handIndex, int duration) {
             if (currentPos == newPos) continue;
 
             QVariantAnimation* reposition = new QVariantAnimation(this);
-            reposition->setDuration(duration);
+            reposition->setDuration(scaled(duration));
             reposition->setStartValue(currentPos);
             reposition->setEndValue(newPos);
             reposition->setEasingCurve(QEasingCurve::InOutQuad);
@@ -299,7 +305,7 @@ void CardsView::repositionHandCards(int handIndex, int duration) {
 void CardsView::flipCard(QGraphicsPixmapItem* item, const Card& card) {
     // Animate shrinking card
     QVariantAnimation* shrink = new QVariantAnimation(this);
-    shrink->setDuration(FLIP_DURATION);
+    shrink->setDuration(scaled(FLIP_DURATION));
     shrink->setStartValue(1.0);
     shrink->setEndValue(0.0);
 
@@ -312,7 +318,7 @@ void CardsView::flipCard(QGraphicsPixmapItem* item, const Card& card) {
         item->setPixmap(cardSprites_.faceFor(card));
 
         QVariantAnimation* grow = new QVariantAnimation(this);
-        grow->setDuration(FLIP_DURATION);
+        grow->setDuration(scaled(FLIP_DURATION));
         grow->setStartValue(0.0);
         grow->setEndValue(1.0);
 
@@ -372,7 +378,7 @@ void CardsView::dealPlayerCard(const Card& card, int handIndex, bool isLastCard)
 
     // Animate drawing from deck to draw point (right below deck)
     QVariantAnimation* drawCard = new QVariantAnimation(this);
-    drawCard->setDuration(DECK_DRAW_DURATION);
+    drawCard->setDuration(scaled(DECK_DRAW_DURATION));
     drawCard->setStartValue(deckPos_);
     drawCard->setEndValue(drawPoint);
 
@@ -382,7 +388,7 @@ void CardsView::dealPlayerCard(const Card& card, int handIndex, bool isLastCard)
 
     // Animate movment from draw point to hand position
     QVariantAnimation* dealCard = new QVariantAnimation(this);
-    dealCard->setDuration(DEAL_TO_HAND_DURATION);
+    dealCard->setDuration(scaled(DEAL_TO_HAND_DURATION));
     dealCard->setStartValue(drawPoint);
     dealCard->setEndValue(handPosition);
 
@@ -419,6 +425,16 @@ void CardsView::dealDealerCard(const Card& card) {
     // Add to dealer hand tracking
     dealerHandCards_.append(item);
 
+    // The second card is the hole card. Decided now rather than when the animation
+    // finishes, since at high speed more cards can be dealt before it lands
+    bool isHoleCard = dealerHandCards_.size() == 2;
+    if (isHoleCard) {
+        holeCard_ = card;
+        holeCardItem_ = item;
+        holeCardDealt_ = false;
+        holeCardFlipPending_ = false;
+    }
+
     // Calculate final centered position for dealer hand
     int numCards = dealerHandCards_.size();
     QVector<int> xOffsets = calculateRelativeCardPositions(numCards);
@@ -435,7 +451,7 @@ void CardsView::dealDealerCard(const Card& card) {
 
     // Animate drawing from deck to draw point (right below deck)
     QVariantAnimation* drawCard = new QVariantAnimation(this);
-    drawCard->setDuration(DECK_DRAW_DURATION);
+    drawCard->setDuration(scaled(DECK_DRAW_DURATION));
     drawCard->setEasingCurve(QEasingCurve::InOutExpo);
     drawCard->setStartValue(deckPos_);
     drawCard->setEndValue(drawPoint);
@@ -446,7 +462,7 @@ void CardsView::dealDealerCard(const Card& card) {
 
     // Animate movement from draw point to hand position
     QVariantAnimation* dealCard = new QVariantAnimation(this);
-    dealCard->setDuration(DEAL_TO_HAND_DURATION);
+    dealCard->setDuration(scaled(DEAL_TO_HAND_DURATION));
     dealCard->setEasingCurve(QEasingCurve::InOutExpo);
     dealCard->setStartValue(drawPoint);
     dealCard->setEndValue(handPosition);
@@ -461,12 +477,14 @@ void CardsView::dealDealerCard(const Card& card) {
     });
 
     // On completion: handle hole card or flip, then reposition
-    connect(dealCard, &QVariantAnimation::finished, this, [this, item, card]() {
-        // Check if this is the second card (hole card)
-        if (dealerHandCards_.size() == 2) {
-            // Save hole card for later flip
-            holeCard_ = card;
-            holeCardItem_ = item;
+    connect(dealCard, &QVariantAnimation::finished, this, [this, item, card, isHoleCard]() {
+        if (isHoleCard) {
+            // Leave the hole card face down, unless it was flipped on the way
+            holeCardDealt_ = true;
+            if (holeCardFlipPending_) {
+                holeCardFlipPending_ = false;
+                flipCard(item, card);
+            }
         } else {
             // Flip regular dealer card
             flipCard(item, card);
@@ -477,8 +495,15 @@ void CardsView::dealDealerCard(const Card& card) {
 }
 
 void CardsView::flipDealerHoleCard() {
-    if (holeCardItem_) {
+    if (!holeCardItem_) {
+        return;
+    }
+
+    // Flipping mid-deal would fight the deal animation, so wait for it to land
+    if (holeCardDealt_) {
         flipCard(holeCardItem_, holeCard_);
+    } else {
+        holeCardFlipPending_ = true;
     }
 }
 
@@ -506,7 +531,7 @@ void CardsView::handleHandSplit(int handIndex) {
 
     // Reposition all player hands to distribute horizontally across the scene
     for (int i = 0; i < playerHandCards_.size(); i++) {
-        repositionHandCards(i, 400); // Longer duration for split animation
+        repositionHandCards(i, SPLIT_DURATION); // Longer duration for split animation
     }
 }
 
@@ -529,7 +554,7 @@ void CardsView::drawCutCard() {
 
     // Animate draw from deck to drawPoint (slightly below deck)
     QVariantAnimation* drawCut = new QVariantAnimation(this);
-    drawCut->setDuration(DECK_DRAW_DURATION);
+    drawCut->setDuration(scaled(DECK_DRAW_DURATION));
     drawCut->setStartValue(deckPos_);
     drawCut->setEndValue(drawPoint);
     drawCut->setEasingCurve(QEasingCurve::InOutExpo);
@@ -540,7 +565,7 @@ void CardsView::drawCutCard() {
 
     // Animate movement to final position below deck
     QVariantAnimation* moveCut = new QVariantAnimation(this);
-    moveCut->setDuration(DEAL_TO_HAND_DURATION);
+    moveCut->setDuration(scaled(DEAL_TO_HAND_DURATION));
     moveCut->setStartValue(drawPoint);
     moveCut->setEndValue(finalPosition);
     moveCut->setEasingCurve(QEasingCurve::InOutExpo);
@@ -598,8 +623,19 @@ void CardsView::setHasSplit(bool newState){
     hasSplit_ = newState;
 }
 
+void CardsView::setClock(const GameClock* clock) {
+    clock_ = clock;
+}
+
 
 void CardsView::cleanUp() {
+    // Stop animations still moving last round's cards, which can outlast the round at
+    // high speed, before their items are deleted. Ones not yet started are never started
+    for (QVariantAnimation* animation : findChildren<QVariantAnimation*>(QString(), Qt::FindDirectChildrenOnly)) {
+        animation->stop();
+        animation->deleteLater();
+    }
+
     // Clear the scene
     scene_->clear();
 
@@ -610,7 +646,10 @@ void CardsView::cleanUp() {
     // Reset pointers (must be done after scene_->clear() to avoid dangling pointers)
     deckItem_ = nullptr;
     cutCardItem_ = nullptr;
+    handSelectionItem_ = nullptr;
     holeCardItem_ = nullptr;
+    holeCardDealt_ = false;
+    holeCardFlipPending_ = false;
 
     // Recreate deck at current position
     updateDeckPosition();
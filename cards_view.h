@@ -11,6 +11,8 @@
 #include "card.h"
 #include "card_sprites.h"
 
+class GameClock;
+
 /// @brief A specialized widget for rendering and animating blackjack cards.
 /// Uses an internal QGraphicsView/QGraphicsScene with dynamic resizing.
 /// Scene dimensions match widget dimensions for optimal space usage.
@@ -54,6 +56,11 @@ public:
     /// @param newState The bool to set it to.
     void setHasSplit(bool newState);
 
+    /// @brief Sets the clock whose time scale every animation is scaled by, so the cards
+    /// keep pace with the game flow at any speed.
+    /// @param clock The clock, or nullptr to animate at normal speed.
+    void setClock(const GameClock* clock);
+
 protected:
     /// @brief Handles resize events - dynamically adjusts scene and repositions all cards.
     /// @param event The resize event.
@@ -99,6 +106,14 @@ private:
     /// @brief The duration of the card flip animation.
     static constexpr int FLIP_DURATION = 150;
 
+    /// @brief The duration of the animation spreading out the hands after a split.
+    static constexpr int SPLIT_DURATION = 400;
+
+    /// @brief Scales an animation duration by the clock's time scale.
+    /// @param duration The duration at normal speed, in milliseconds.
+    /// @return The duration to animate for, in milliseconds.
+    int scaled(int duration) const;
+
     /// @brief Calculates dealer hand Y position based on current scene height.
     /// @return Y position in scene coordinates.
     int getDealerHandY() const;
@@ -185,6 +200,16 @@ private:
     /// @brief The dealer's hole card data (stored for delayed flip).
     Card holeCard_;
 
+    /// @brief True once the hole card has reached the dealer's hand.
+    bool holeCardDealt_;
+
+    /// @brief True if the hole card was asked to flip before it reached the dealer's
+    /// hand, so it flips as soon as it arrives.
+    bool holeCardFlipPending_;
+
+    /// @brief The clock animations are scaled by, or nullptr for normal speed.
+    const GameClock* clock_;
+
     /// @brief Current scale factor for card items.
     float cardScale_;
 };
@@ -0,0 +1,82 @@
+#ifndef COMPOSITION_H
+#define COMPOSITION_H
+
+#include <array>
+#include <QtGlobal>
+#include "card.h"
+
+/// @brief The number of cards of each blackjack value in a set of cards (such as the
+/// undealt cards in a shoe). Tens and face cards are counted together, since only a card's
+/// value matters to the outcome of a hand. The composition also keeps a hash of its
+/// counts, updated as cards are added and removed, so it can be used as a cache key
+/// without rescanning the counts. The counts should only be changed through add, remove,
+/// and setCount.
+struct Composition {
+    /// @brief The number of distinct blackjack values (ace, 2-9, and ten).
+    static constexpr int VALUE_COUNT = 10;
+
+    /// @brief The number of cards of each value, indexed by value index (see indexOf).
+    std::array<int, VALUE_COUNT> counts {};
+
+    /// @brief The total number of cards.
+    int total = 0;
+
+    /// @brief A hash of the counts: the sum of VALUE_HASHES[i] * counts[i].
+    quint64 hash = 0;
+
+    /// @brief The amount each card of a value index adds to the hash.
+    static constexpr quint64 VALUE_HASHES[VALUE_COUNT] {
+        0x8F93B7D480C788FCull, 0x2CD6CACDA7AFB7F9ull, 0xD220E90CEB6AE8A6ull, 0x67B214564E7620FCull,
+        0x0027076850D22CE1ull, 0x77C5B579226A0C84ull, 0x4AEB9A67AD995FC3ull, 0xFC640C8E6DB83869ull,
+        0x0D01B6F7D59B7A61ull, 0xEB14D0A33CF444D7ull
+    };
+
+    /// @brief Gets the value index of a card: 0 for an ace, 1-8 for 2-9, and 9 for tens
+    /// and face cards.
+    static constexpr int indexOf(Card card) {
+        return card.rank == Card::Rank::Ace ? 0 : card.getBlackjackValue() - 1;
+    }
+
+    /// @brief Gets the blackjack value of a value index, counting aces as 1.
+    static constexpr int valueOf(int index) {
+        return index + 1;
+    }
+
+    /// @brief Adds a card of the given value index.
+    void add(int index) {
+        ++counts[index];
+        ++total;
+        hash += VALUE_HASHES[index];
+    }
+
+    /// @brief Removes a card of the given value index.
+    void remove(int index) {
+        --counts[index];
+        --total;
+        hash -= VALUE_HASHES[index];
+    }
+
+    /// @brief Sets the number of cards of the given value index.
+    void setCount(int index, int count) {
+        int change = count - counts[index];
+        counts[index] = count;
+        total += change;
+        hash += static_cast<quint64>(static_cast<qint64>(change)) * VALUE_HASHES[index];
+    }
+
+    /// @brief Adds a card.
+    void add(Card card) {
+        add(indexOf(card));
+    }
+
+    /// @brief Removes a card.
+    void remove(Card card) {
+        remove(indexOf(card));
+    }
+
+    bool operator==(const Composition& other) const {
+        return hash == other.hash && counts == other.counts;
+    }
+};
+
+#endif // COMPOSITION_H
@@ -0,0 +1,65 @@
+#include "counting_system.h"
+#include "round_engine.h"
+
+namespace {
+
+/// @brief Returns true if the Hi-Lo system's tags match Card::HI_LO_VALUES.
+constexpr bool matchesCardHiLo() {
+    const CountingSystem& hiLo = COUNTING_SYSTEMS[static_cast<int>(CountingSystem::Id::HiLo)];
+    for (int rank = 0; rank < Card::RANK_COUNT; ++rank) {
+        if (hiLo.tags[rank] != Card::HI_LO_VALUES[rank])
+            return false;
+    }
+    return true;
+}
+
+static_assert(matchesCardHiLo(), "The Hi-Lo counting system should match Card::getHiLoValue");
+
+}
+
+// Counting systems
+
+double CountingSystem::getTrueCount(double runningCount, double decksRemaining) const {
+    if (decksRemaining <= 0)
+        return 0;
+    return getImbalance() + (runningCount - pivot) / decksRemaining;
+}
+
+bool CountingSystem::fromKey(const QString& key, Id& id) {
+    for (int i = 0; i < COUNT; ++i) {
+        if (key.toLower() == COUNTING_SYSTEMS[i].key) {
+            id = static_cast<Id>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Tracking
+
+CountTracker::CountTracker(int decks) : decks_(decks) {}
+
+void CountTracker::reset(int decks) {
+    decks_ = decks;
+    counts_.fill(0);
+    cardsSeen_ = 0;
+}
+
+void CountTracker::observeRound(const RoundEngine& engine) {
+    for (int i = 0; i < engine.getHandCount(); ++i)
+        observe(engine.getPlayerHand(i).cards());
+    observe(engine.getDealerHand().cards());
+}
+
+double CountTracker::getRunningCount(CountingSystem::Id id) const {
+    const CountingSystem& system = CountingSystem::get(id);
+    return system.getInitialRunningCount(decks_) + static_cast<double>(counts_[static_cast<int>(id)]) / system.scale;
+}
+
+double CountTracker::getTrueCount(CountingSystem::Id id, double decksRemaining) const {
+    return CountingSystem::get(id).getTrueCount(getRunningCount(id), decksRemaining);
+}
+
+double CountTracker::getTrueCount(CountingSystem::Id id) const {
+    return getTrueCount(id, (decks_ * 52 - cardsSeen_) / 52.0);
+}
@@ -0,0 +1,184 @@
+#ifndef COUNTING_SYSTEM_H
+#define COUNTING_SYSTEM_H
+
+#include <array>
+#include <cstdint>
+#include <QString>
+#include <QVector>
+#include "card.h"
+
+class RoundEngine;
+
+/// @brief A card counting system: a tag for each rank, added to the running count as each
+/// card is seen. Tags are stored as integers in units of 1/scale, so systems with half
+/// tags (Wong Halves) are counted exactly.
+///
+/// A balanced system's tags sum to zero over a deck, and its true count is the running
+/// count per deck remaining. An unbalanced system (KO) gains imbalance per deck, so its
+/// running count starts at pivot - imbalance * decks; at the pivot its true count is the
+/// imbalance, and in general the true count is imbalance + (running - pivot) / decks
+/// remaining, which is what the balanced count would be for the same cards.
+struct CountingSystem {
+    /// @brief The counting systems, in the order of COUNTING_SYSTEMS.
+    enum class Id : std::uint8_t {
+        HiLo,
+        KnockOut,
+        HiOptII,
+        OmegaII,
+        Zen,
+        WongHalves
+    };
+
+    /// @brief The number of counting systems.
+    static constexpr int COUNT = 6;
+
+    /// @brief The name shown to the player.
+    const char* name;
+
+    /// @brief The short name used on the command line.
+    const char* key;
+
+    /// @brief The tag of each rank, in units of 1/scale, indexed by rank.
+    std::int8_t tags[Card::RANK_COUNT];
+
+    /// @brief The number of tag units in one point of the count.
+    std::int8_t scale;
+
+    /// @brief For unbalanced systems, the running count at which the true count equals
+    /// the imbalance. Zero for balanced systems.
+    std::int8_t pivot;
+
+    /// @brief Gets the sum of the tags over a 52-card deck, in points.
+    constexpr int getImbalance() const {
+        int sum = 0;
+        for (int rank = 1; rank < Card::RANK_COUNT; ++rank)
+            sum += 4 * tags[rank];
+        return sum / scale;
+    }
+
+    /// @brief Returns true if the tags sum to zero over a deck.
+    constexpr bool isBalanced() const {
+        return getImbalance() == 0;
+    }
+
+    /// @brief Gets the running count before any card of a fresh shoe is seen.
+    /// @param decks The number of decks in the shoe.
+    constexpr int getInitialRunningCount(int decks) const {
+        return isBalanced() ? 0 : pivot - getImbalance() * decks;
+    }
+
+    /// @brief Converts a running count to a true count.
+    /// @param runningCount The running count, from getInitialRunningCount.
+    /// @param decksRemaining The number of decks not yet seen.
+    double getTrueCount(double runningCount, double decksRemaining) const;
+
+    /// @brief Gets a counting system.
+    static const CountingSystem& get(Id id);
+
+    /// @brief Finds a counting system by its key (e.g., "hilo" or "ko").
+    /// @param key The key, ignoring case.
+    /// @param id Receives the system if the key is known.
+    /// @return True if the key is known.
+    static bool fromKey(const QString& key, Id& id);
+};
+
+/// @brief Every counting system, indexed by CountingSystem::Id.
+inline constexpr CountingSystem COUNTING_SYSTEMS[CountingSystem::COUNT] {
+    //                     Cut   A  2  3  4  5  6  7  8   9  10   J   Q   K
+    { "Hi-Lo",       "hilo",   { 0, -1, 1, 1, 1, 1, 1, 0, 0,  0, -1, -1, -1, -1 }, 1, 0 },
+    { "KO",          "ko",     { 0, -1, 1, 1, 1, 1, 1, 1, 0,  0, -1, -1, -1, -1 }, 1, 4 },
+    { "Hi-Opt II",   "hiopt2", { 0,  0, 1, 1, 2, 2, 1, 1, 0,  0, -2, -2, -2, -2 }, 1, 0 },
+    { "Omega II",    "omega2", { 0,  0, 1, 1, 2, 2, 2, 1, 0, -1, -2, -2, -2, -2 }, 1, 0 },
+    { "Zen",         "zen",    { 0, -1, 1, 1, 2, 2, 2, 1, 0,  0, -2, -2, -2, -2 }, 1, 0 },
+    { "Wong Halves", "halves", { 0, -2, 1, 2, 2, 3, 2, 1, 0, -1, -2, -2, -2, -2 }, 2, 0 },
+};
+
+inline const CountingSystem& CountingSystem::get(Id id) {
+    return COUNTING_SYSTEMS[static_cast<int>(id)];
+}
+
+static_assert(COUNTING_SYSTEMS[static_cast<int>(CountingSystem::Id::HiLo)].isBalanced()
+                  && COUNTING_SYSTEMS[static_cast<int>(CountingSystem::Id::HiOptII)].isBalanced()
+                  && COUNTING_SYSTEMS[static_cast<int>(CountingSystem::Id::OmegaII)].isBalanced()
+                  && COUNTING_SYSTEMS[static_cast<int>(CountingSystem::Id::Zen)].isBalanced()
+                  && COUNTING_SYSTEMS[static_cast<int>(CountingSystem::Id::WongHalves)].isBalanced(),
+              "Balanced counting systems should sum to zero over a deck");
+static_assert(COUNTING_SYSTEMS[static_cast<int>(CountingSystem::Id::KnockOut)].getImbalance() == 4,
+              "KO should gain 4 per deck");
+
+/// @brief Keeps the running count of every CountingSystem at once. Each card seen adds
+/// one row of a constexpr table, holding that rank's tag in every system, to the counts,
+/// so all the systems are updated in a single pass with no branches.
+class CountTracker {
+public:
+    /// @brief The number of counts kept, padded so a row of tags fills a whole vector
+    /// register.
+    static constexpr int LANES = 8;
+
+    /// @brief Creates a tracker for a fresh shoe.
+    /// @param decks The number of decks in the shoe.
+    explicit CountTracker(int decks = 6);
+
+    /// @brief Starts counting a fresh shoe.
+    /// @param decks The number of decks in the shoe.
+    void reset(int decks);
+
+    /// @brief Starts counting a fresh shoe of the same size.
+    void reset() { reset(decks_); }
+
+    /// @brief Counts a card in every system.
+    void observe(Card card) {
+        const std::array<std::int8_t, LANES>& row = TAG_ROWS[static_cast<int>(card.rank)];
+        for (int i = 0; i < LANES; ++i)
+            counts_[i] += row[i];
+        cardsSeen_++;
+    }
+
+    /// @brief Counts every card of a set of cards.
+    void observe(const QVector<Card>& cards) {
+        for (Card card : cards)
+            observe(card);
+    }
+
+    /// @brief Counts every card of a finished round: every player hand and the dealer's
+    /// hand, including the hole card.
+    void observeRound(const RoundEngine& engine);
+
+    /// @brief Gets a system's running count, starting from its initial running count.
+    double getRunningCount(CountingSystem::Id id) const;
+
+    /// @brief Gets a system's true count.
+    /// @param decksRemaining The number of decks not yet seen.
+    double getTrueCount(CountingSystem::Id id, double decksRemaining) const;
+
+    /// @brief Gets a system's true count, taking every card not yet observed as
+    /// remaining.
+    double getTrueCount(CountingSystem::Id id) const;
+
+    /// @brief Gets the number of cards observed since the last reset.
+    int getCardsSeen() const { return cardsSeen_; }
+
+private:
+    /// @brief The tag of each rank in every system, indexed by rank and then system.
+    static constexpr std::array<std::array<std::int8_t, LANES>, Card::RANK_COUNT> TAG_ROWS = [] {
+        std::array<std::array<std::int8_t, LANES>, Card::RANK_COUNT> rows {};
+        for (int rank = 0; rank < Card::RANK_COUNT; ++rank) {
+            for (int system = 0; system < CountingSystem::COUNT; ++system)
+                rows[rank][system] = COUNTING_SYSTEMS[system].tags[rank];
+        }
+        return rows;
+    }();
+
+    /// @brief The sum of the tags seen in each system, in tag units.
+    std::array<std::int32_t, LANES> counts_ {};
+
+    /// @brief The number of decks in the shoe.
+    int decks_;
+
+    /// @brief The number of cards observed since the last reset.
+    int cardsSeen_ = 0;
+};
+
+static_assert(CountingSystem::COUNT <= CountTracker::LANES, "Every counting system should have a lane");
+
+#endif // COUNTING_SYSTEM_H
@@ -0,0 +1,61 @@
+#include "dealer_outcome_cache.h"
+#include <iterator>
+
+DealerOutcomeCache::DealerOutcomeCache(std::size_t capacity) :
+    capacity_(qMax<std::size_t>(capacity, 1))
+{
+    index_.reserve(capacity_);
+}
+
+DealerOutcomeCache::DealerOutcomeCache(const DealerOutcomeCache& other) :
+    capacity_(other.capacity_), entries_(other.entries_), hits_(other.hits_), misses_(other.misses_)
+{
+    reindex();
+}
+
+DealerOutcomeCache& DealerOutcomeCache::operator=(const DealerOutcomeCache& other) {
+    if (this != &other) {
+        capacity_ = other.capacity_;
+        entries_ = other.entries_;
+        hits_ = other.hits_;
+        misses_ = other.misses_;
+        reindex();
+    }
+    return *this;
+}
+
+const DealerOutcomes& DealerOutcomeCache::get(int upcardIndex, const Composition& composition, const Ruleset& rules) {
+    Key key { composition, upcardIndex, rules.dealerHitsSoft17, rules.dealerPeeks };
+
+    auto found = index_.find(key);
+    if (found != index_.end()) {
+        ++hits_;
+        entries_.splice(entries_.begin(), entries_, found->second);
+        return found->second->outcomes;
+    }
+
+    ++misses_;
+    if (entries_.size() >= capacity_) {
+        // Reuse the least recently used entry's node rather than allocating a new one
+        index_.erase(entries_.back().key);
+        entries_.splice(entries_.begin(), entries_, std::prev(entries_.end()));
+        entries_.front() = Entry { key, DealerOutcomes::compute(upcardIndex, composition, rules) };
+    }
+    else {
+        entries_.push_front(Entry { key, DealerOutcomes::compute(upcardIndex, composition, rules) });
+    }
+    index_.emplace(key, entries_.begin());
+    return entries_.front().outcomes;
+}
+
+void DealerOutcomeCache::clear() {
+    entries_.clear();
+    index_.clear();
+}
+
+void DealerOutcomeCache::reindex() {
+    index_.clear();
+    index_.reserve(capacity_);
+    for (auto entry = entries_.begin(); entry != entries_.end(); ++entry)
+        index_.emplace(entry->key, entry);
+}
@@ -0,0 +1,101 @@
+#ifndef DEALER_OUTCOME_CACHE_H
+#define DEALER_OUTCOME_CACHE_H
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <QtGlobal>
+#include "composition.h"
+#include "dealer_outcomes.h"
+#include "ruleset.h"
+
+/// @brief A bounded cache of dealer outcome probabilities, keyed by the dealer's upcard,
+/// the dealer rules (hitting soft 17 and peeking), and the composition the dealer draws
+/// from. Looking up a composition uses the hash it keeps incrementally, so a query that
+/// hits the cache costs a hash table probe and a comparison of the counts rather than a
+/// solve of the dealer's hand. When the cache is full, the least recently used entry is
+/// evicted.
+///
+/// The cache is not thread-safe; each thread should use its own.
+class DealerOutcomeCache {
+public:
+    /// @brief The number of entries kept by default. Each entry takes about 200 bytes.
+    static constexpr std::size_t DEFAULT_CAPACITY = 16384;
+
+    /// @brief Creates an empty cache.
+    /// @param capacity The most entries to keep.
+    explicit DealerOutcomeCache(std::size_t capacity = DEFAULT_CAPACITY);
+
+    DealerOutcomeCache(const DealerOutcomeCache& other);
+    DealerOutcomeCache& operator=(const DealerOutcomeCache& other);
+
+    /// @brief Gets the dealer's outcome probabilities, computing and caching them if they
+    /// are not already cached.
+    /// @param upcardIndex The value index of the dealer's upcard (see Composition::indexOf).
+    /// @param composition The cards the dealer's hole card and hits are drawn from.
+    /// @param rules The rules of the game. Only dealerHitsSoft17 and dealerPeeks are used.
+    /// @return The outcome probabilities. The reference is valid until the next call to get
+    /// or clear.
+    const DealerOutcomes& get(int upcardIndex, const Composition& composition, const Ruleset& rules);
+
+    /// @brief Removes every entry from the cache.
+    void clear();
+
+    /// @brief Gets the number of entries in the cache.
+    std::size_t size() const { return entries_.size(); }
+
+    /// @brief Gets the number of queries answered from the cache.
+    quint64 getHits() const { return hits_; }
+
+    /// @brief Gets the number of queries that had to be computed.
+    quint64 getMisses() const { return misses_; }
+
+private:
+    /// @brief Identifies one set of cached probabilities.
+    struct Key {
+        Composition composition;
+        int upcardIndex;
+        bool dealerHitsSoft17;
+        bool dealerPeeks;
+
+        bool operator==(const Key& other) const {
+            return upcardIndex == other.upcardIndex && dealerHitsSoft17 == other.dealerHitsSoft17
+                   && dealerPeeks == other.dealerPeeks && composition == other.composition;
+        }
+    };
+
+    /// @brief Hashes a key from the composition's incremental hash and the other fields.
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            quint64 hash = key.composition.hash ^ (static_cast<quint64>(key.upcardIndex) << 2)
+                           ^ (key.dealerHitsSoft17 ? 1 : 0) ^ (key.dealerPeeks ? 2 : 0);
+            return static_cast<std::size_t>((hash * 0x9E3779B97F4A7C15ull) >> 16);
+        }
+    };
+
+    /// @brief A cached entry.
+    struct Entry {
+        Key key;
+        DealerOutcomes outcomes;
+    };
+
+    /// @brief The most entries to keep.
+    std::size_t capacity_;
+
+    /// @brief The entries, from most to least recently used.
+    std::list<Entry> entries_;
+
+    /// @brief The entry for each key.
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+
+    /// @brief The number of queries answered from the cache.
+    quint64 hits_ = 0;
+
+    /// @brief The number of queries that had to be computed.
+    quint64 misses_ = 0;
+
+    /// @brief Rebuilds index_ to point into entries_, after entries_ is copied.
+    void reindex();
+};
+
+#endif // DEALER_OUTCOME_CACHE_H
@@ -0,0 +1,129 @@
+#include "dealer_outcomes.h"
+#include <vector>
+#include <QtGlobal>
+
+namespace {
+
+/// @brief The number of slots in the solver's memo table. The dealer's hand never has
+/// more than a few hundred distinct non-final states, so the table stays sparse.
+constexpr int MEMO_SLOTS = 2048;
+
+/// @brief Solves the dealer's hand for one upcard and composition. Each state is
+/// identified by the cards drawn so far, packed four bits per value index, which also
+/// determines the dealer's total.
+class DealerSolver {
+public:
+    DealerSolver(int upcardIndex, const Composition& composition, const Ruleset& rules) :
+        upcardIndex_(upcardIndex), composition_(composition), rules_(rules),
+        memoKeys_(MEMO_SLOTS, EMPTY_KEY), memoStates_(MEMO_SLOTS, -1) {
+        states_.reserve(512);
+    }
+
+    /// @brief Solves the hand from the upcard alone.
+    DealerOutcomes solve() {
+        int upcardValue = Composition::valueOf(upcardIndex_);
+        DealerOutcomes result;
+        result.probabilities = states_[fromState(upcardValue, upcardIndex_ == 0, 1, 0)];
+        return result;
+    }
+
+private:
+    using Probabilities = std::array<double, DealerOutcomes::OUTCOME_COUNT>;
+
+    /// @brief Marks an unused slot in the memo table. No state has this key, since it
+    /// would take fifteen cards of every value.
+    static constexpr quint64 EMPTY_KEY = ~0ull;
+
+    /// @brief Gets the outcome a hand ends with, or -1 if the dealer must draw.
+    int finalOutcome(int hardTotal, bool hasAce, int cardCount) const {
+        bool isSoft = hasAce && hardTotal <= 11;
+        int value = isSoft ? hardTotal + 10 : hardTotal;
+        if (cardCount == 2 && value == 21)
+            return DealerOutcomes::Blackjack;
+        if (value > 21)
+            return value == 22 ? DealerOutcomes::Bust22 : DealerOutcomes::Bust;
+        if (value > 17 || (value == 17 && !(isSoft && rules_.dealerHitsSoft17)))
+            return DealerOutcomes::Total17 + value - 17;
+        return -1;
+    }
+
+    /// @brief Gets the outcome probabilities from a state where the dealer must draw.
+    /// @param hardTotal The dealer's total with aces counted as 1.
+    /// @param hasAce True if the dealer holds an ace.
+    /// @param cardCount The number of cards in the dealer's hand.
+    /// @param drawnKey The cards drawn after the upcard, packed four bits per value index.
+    /// @return The index of the state's probabilities in states_.
+    int fromState(int hardTotal, bool hasAce, int cardCount, quint64 drawnKey) {
+        int slot = static_cast<int>((drawnKey * 0x9E3779B97F4A7C15ull) >> 53) & (MEMO_SLOTS - 1);
+        while (memoKeys_[slot] != EMPTY_KEY) {
+            if (memoKeys_[slot] == drawnKey)
+                return memoStates_[slot];
+            slot = (slot + 1) & (MEMO_SLOTS - 1);
+        }
+
+        // Once the dealer has peeked, the hole card cannot complete a blackjack
+        int excludedIndex = -1;
+        if (cardCount == 1 && rules_.dealerPeeks) {
+            if (upcardIndex_ == 0)
+                excludedIndex = Composition::VALUE_COUNT - 1;
+            else if (upcardIndex_ == Composition::VALUE_COUNT - 1)
+                excludedIndex = 0;
+        }
+        int drawable = composition_.total - (excludedIndex >= 0 ? composition_.counts[excludedIndex] : 0);
+
+        Probabilities result {};
+        if (drawable > 0) {
+            for (int i = 0; i < Composition::VALUE_COUNT; ++i) {
+                int count = composition_.counts[i];
+                if (count == 0 || i == excludedIndex) continue;
+
+                double p = static_cast<double>(count) / drawable;
+                int nextHardTotal = hardTotal + Composition::valueOf(i);
+                bool nextHasAce = hasAce || i == 0;
+                int outcome = finalOutcome(nextHardTotal, nextHasAce, cardCount + 1);
+                if (outcome >= 0) {
+                    result[outcome] += p;
+                    continue;
+                }
+
+                composition_.remove(i);
+                int next = fromState(nextHardTotal, nextHasAce, cardCount + 1, drawnKey + (1ull << (4 * i)));
+                composition_.add(i);
+                for (int j = 0; j < DealerOutcomes::OUTCOME_COUNT; ++j)
+                    result[j] += p * states_[next][j];
+            }
+        }
+
+        // The recursion may have filled the slot found above, so probe again
+        while (memoKeys_[slot] != EMPTY_KEY)
+            slot = (slot + 1) & (MEMO_SLOTS - 1);
+        memoKeys_[slot] = drawnKey;
+        memoStates_[slot] = static_cast<int>(states_.size());
+        states_.push_back(result);
+        return memoStates_[slot];
+    }
+
+    /// @brief The value index of the dealer's upcard.
+    int upcardIndex_;
+
+    /// @brief The cards left to draw from, updated as the recursion draws them.
+    Composition composition_;
+
+    /// @brief The rules of the game.
+    const Ruleset& rules_;
+
+    /// @brief The key stored in each slot of the memo table (open addressing).
+    std::vector<quint64> memoKeys_;
+
+    /// @brief The index in states_ of each slot's probabilities.
+    std::vector<int> memoStates_;
+
+    /// @brief The probabilities of every solved state.
+    std::vector<Probabilities> states_;
+};
+
+}
+
+DealerOutcomes DealerOutcomes::compute(int upcardIndex, const Composition& composition, const Ruleset& rules) {
+    return DealerSolver(upcardIndex, composition, rules).solve();
+}
@@ -0,0 +1,41 @@
+#ifndef DEALER_OUTCOMES_H
+#define DEALER_OUTCOMES_H
+
+#include <array>
+#include "composition.h"
+#include "ruleset.h"
+
+/// @brief The probability of each way the dealer's hand can end, given the dealer's upcard
+/// and the cards the rest of the dealer's hand will be drawn from.
+struct DealerOutcomes {
+    /// @brief The ways the dealer's hand can end. A bust of exactly 22 is kept apart from
+    /// other busts because it pushes under the pushOnDealer22 rule.
+    enum Outcome {
+        Total17,
+        Total18,
+        Total19,
+        Total20,
+        Total21,
+        Blackjack,
+        Bust22,
+        Bust,
+        OUTCOME_COUNT
+    };
+
+    /// @brief The probability of each outcome, indexed by Outcome.
+    std::array<double, OUTCOME_COUNT> probabilities {};
+
+    /// @brief Computes the exact probability of each outcome by recursing over every card
+    /// the dealer can draw, removing each card from the composition as it is drawn.
+    /// States reached by drawing the same cards in a different order are only solved
+    /// once. If the dealer peeks and the upcard is an ace or a ten, the hole card is
+    /// conditioned on the dealer not having a blackjack, since the player only acts once
+    /// the peek has come up empty.
+    /// @param upcardIndex The value index of the dealer's upcard (see Composition::indexOf).
+    /// @param composition The cards the dealer's hole card and hits are drawn from.
+    /// @param rules The rules of the game. Only dealerHitsSoft17 and dealerPeeks are used.
+    /// @return The probability of each outcome.
+    static DealerOutcomes compute(int upcardIndex, const Composition& composition, const Ruleset& rules);
+};
+
+#endif // DEALER_OUTCOMES_H
@@ -0,0 +1,113 @@
+#include "decision_capture.h"
+#include <cmath>
+#include <QDateTime>
+#include <QDir>
+#include <QStandardPaths>
+#include "hand.h"
+
+DecisionCapture::DecisionCapture(BlackjackGame* game, QObject* parent)
+    : QObject(parent), game_(game), inRound_(false), decisionPending_(false), pending_(),
+      settledHands_(0) {
+    connect(game_, &BlackjackGame::betPlaced, this, &DecisionCapture::onBetPlaced);
+    connect(game_, &BlackjackGame::playerCardDealt, this, &DecisionCapture::onPlayerCardDealt);
+    connect(game_, &BlackjackGame::splitHand, this, &DecisionCapture::onHandSplit);
+    connect(game_, &BlackjackGame::playerTurn, this, &DecisionCapture::onPlayerTurn);
+    connect(game_, &BlackjackGame::dealerTurnStarted, this, &DecisionCapture::onDealerTurnStarted);
+    connect(game_, &BlackjackGame::roundEnded, this, &DecisionCapture::onRoundEnded);
+}
+
+void DecisionCapture::addSink(DecisionSink* sink) {
+    sinks_.append(sink);
+}
+
+QString DecisionCapture::getDefaultBasePath() {
+    QDir directory(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+    return directory.filePath(QString("analytics/decisions-%1").arg(QDateTime::currentMSecsSinceEpoch()));
+}
+
+void DecisionCapture::onBetPlaced(int amount) {
+    if (inRound_)
+        return;
+    inRound_ = true;
+    decisionPending_ = false;
+    handBets_ = { amount };
+    rows_.clear();
+    settledHands_ = 0;
+}
+
+void DecisionCapture::onPlayerCardDealt(Card, int handIndex, bool isLastCard) {
+    if (!decisionPending_ || handIndex != pending_.handIndex)
+        return;
+
+    if (isLastCard) {
+        handBets_[handIndex] *= 2;
+        completeDecision(BasicStrategyChecker::PlayerAction::Double);
+        return;
+    }
+    completeDecision(BasicStrategyChecker::PlayerAction::Hit);
+
+    // The game waits for another action only if the hit left the hand below 21
+    if (BlackjackGame::getHandValue(game_->getCurrentHand()) < 21)
+        beginDecision(handIndex);
+}
+
+void DecisionCapture::onHandSplit(int handIndex) {
+    if (decisionPending_)
+        completeDecision(BasicStrategyChecker::PlayerAction::Split);
+    handBets_.insert(handIndex + 1, handBets_[handIndex]);
+}
+
+void DecisionCapture::onPlayerTurn(int handIndex) {
+    if (decisionPending_)
+        completeDecision(BasicStrategyChecker::PlayerAction::Stand);
+    beginDecision(handIndex);
+}
+
+void DecisionCapture::onDealerTurnStarted() {
+    if (decisionPending_)
+        completeDecision(BasicStrategyChecker::PlayerAction::Stand);
+}
+
+void DecisionCapture::onRoundEnded(BlackjackGame::GameResult result, int payout, int handIndex, int totalHands) {
+    if (!inRound_)
+        return;
+    if (decisionPending_ && result == BlackjackGame::GameResult::Surrender)
+        completeDecision(BasicStrategyChecker::PlayerAction::Surrender);
+
+    for (PendingRow& pending : rows_) {
+        if (pending.handIndex == handIndex) {
+            pending.row.result = result;
+            pending.row.bet = handBets_[handIndex];
+            pending.row.payout = payout;
+        }
+    }
+
+    if (++settledHands_ < totalHands)
+        return;
+    for (DecisionSink* sink : sinks_) {
+        for (const PendingRow& pending : rows_)
+            sink->write(pending.row);
+    }
+    rows_.clear();
+    inRound_ = false;
+}
+
+void DecisionCapture::beginDecision(int handIndex) {
+    Hand hand(game_->getCurrentHand());
+    pending_.handIndex = handIndex;
+    pending_.row.upcard = static_cast<quint8>(game_->getDealerUpcard().getBlackjackValue());
+    pending_.row.playerTotal = static_cast<quint8>(hand.getValue());
+    pending_.row.handKey = static_cast<quint8>(BasicStrategyChecker::getHandKey(hand));
+    pending_.row.bestAction = game_->getBestMove();
+    // The column is the Hi-Lo count (the count the index plays use), whichever count the
+    // player is practicing
+    int trueCount = static_cast<int>(std::floor(game_->getTrueCount(CountingSystem::Id::HiLo)));
+    pending_.row.trueCount = static_cast<qint8>(qBound(-128, trueCount, 127));
+    decisionPending_ = true;
+}
+
+void DecisionCapture::completeDecision(BasicStrategyChecker::PlayerAction action) {
+    pending_.row.action = action;
+    rows_.append(pending_);
+    decisionPending_ = false;
+}
@@ -0,0 +1,95 @@
+#ifndef DECISION_CAPTURE_H
+#define DECISION_CAPTURE_H
+
+#include <QObject>
+#include <QVector>
+#include "blackjack_game.h"
+#include "decision_export.h"
+
+/// @brief Captures every decision the player makes in a BlackjackGame, from the game's
+/// signals alone, and passes each to the sinks once its hand has been settled.
+///
+/// The game does not signal actions, so each is worked out from what follows it: a card
+/// dealt to the hand is a hit (or a double, if it is the hand's last card), a split
+/// signal is a split, a surrender result is a surrender, and moving on to the next hand
+/// or the dealer's turn is a stand. The state the decision was made in (the hand, the
+/// upcard, the true count, and the recommended action) is taken when the decision
+/// becomes due: on the player's turn, and after each hit that leaves the hand below 21.
+/// A split is counted against the first of the two hands it makes.
+class DecisionCapture : public QObject {
+    Q_OBJECT
+
+public:
+    /// @brief Starts capturing a game's decisions.
+    /// @param game The game to capture; must outlive the capture.
+    /// @param parent The parent of this object.
+    explicit DecisionCapture(BlackjackGame* game, QObject* parent = nullptr);
+
+    /// @brief Adds a sink to pass decisions to. The sink is not owned and must outlive
+    /// the capture.
+    void addSink(DecisionSink* sink);
+
+    /// @brief Gets a path in the app's data directory, without an extension, for a new
+    /// session's export files.
+    static QString getDefaultBasePath();
+
+private slots:
+    /// @brief Starts a round on the first bet, and otherwise ignores bets (doubles and
+    /// splits are tracked from their cards and signals).
+    void onBetPlaced(int amount);
+
+    /// @brief Records a pending decision as a hit or a double.
+    void onPlayerCardDealt(Card card, int handIndex, bool isLastCard);
+
+    /// @brief Records a pending decision as a split.
+    void onHandSplit(int handIndex);
+
+    /// @brief Records a pending decision as a stand and starts the next one.
+    void onPlayerTurn(int handIndex);
+
+    /// @brief Records a pending decision as a stand.
+    void onDealerTurnStarted();
+
+    /// @brief Completes the rows of the settled hand, and passes the round's rows to the
+    /// sinks once every hand is settled.
+    void onRoundEnded(BlackjackGame::GameResult result, int payout, int handIndex, int totalHands);
+
+private:
+    /// @brief A captured decision whose hand has not yet been settled.
+    struct PendingRow {
+        int handIndex;
+        DecisionRow row;
+    };
+
+    /// @brief Takes the state of the current hand as the next decision.
+    void beginDecision(int handIndex);
+
+    /// @brief Records the pending decision as the given action.
+    void completeDecision(BasicStrategyChecker::PlayerAction action);
+
+    /// @brief The game being captured.
+    BlackjackGame* game_;
+
+    /// @brief Where completed rows are passed.
+    QVector<DecisionSink*> sinks_;
+
+    /// @brief True between a round's bet and the settling of its last hand.
+    bool inRound_;
+
+    /// @brief True while the player has a decision to make.
+    bool decisionPending_;
+
+    /// @brief The decision the player has to make, if decisionPending_.
+    PendingRow pending_;
+
+    /// @brief The bet on each hand of the round.
+    QVector<int> handBets_;
+
+    /// @brief The round's decisions so far.
+    QVector<PendingRow> rows_;
+
+    /// @brief The number of the round's hands settled so far.
+    int settledHands_;
+};
+
+#endif // DECISION_CAPTURE_H
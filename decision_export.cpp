@@ -0,0 +1,315 @@
+#include "decision_export.h"
+#include <cstring>
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+
+namespace {
+
+/// @brief How a column's values are stored.
+enum class ColumnType : quint8 {
+    UInt8,
+    Int8,
+    Int32,
+    /// @brief A one-byte code, named by the column's dictionary.
+    Dictionary
+};
+
+/// @brief The name and type of a column.
+struct ColumnInfo {
+    const char* name;
+    ColumnType type;
+};
+
+/// @brief Every column, in the order they are stored.
+constexpr ColumnInfo COLUMNS[] {
+    { "upcard", ColumnType::UInt8 },
+    { "player_total", ColumnType::UInt8 },
+    { "hand_key", ColumnType::UInt8 },
+    { "action", ColumnType::Dictionary },
+    { "best_action", ColumnType::Dictionary },
+    { "true_count", ColumnType::Int8 },
+    { "result", ColumnType::Dictionary },
+    { "bet", ColumnType::Int32 },
+    { "payout", ColumnType::Int32 }
+};
+
+/// @brief The name of each player action, indexed by its value.
+constexpr const char* ACTION_NAMES[] { "Hit", "Stand", "Double", "Split", "SplitIfDas", "Surrender" };
+
+/// @brief The name of each hand result, indexed by its value.
+constexpr const char* RESULT_NAMES[] { "Win", "Lose", "Push", "Blackjack", "Surrender" };
+
+/// @brief The value written to check that a file is read in the byte order it was written in.
+constexpr quint32 BYTE_ORDER_MARK = 0x01020304;
+
+/// @brief Writes a string as its length and its bytes.
+void writeName(QDataStream& out, const char* name) {
+    quint8 length = static_cast<quint8>(std::strlen(name));
+    out << length;
+    out.writeRawData(name, length);
+}
+
+/// @brief Reads a string written by writeName and checks it.
+/// @return True if the string read is expected.
+bool readName(QDataStream& in, const char* expected) {
+    quint8 length;
+    in >> length;
+    char name[256];
+    return in.readRawData(name, length) == length && length == std::strlen(expected)
+        && std::memcmp(name, expected, length) == 0;
+}
+
+/// @brief Gets the names of a dictionary-encoded column's codes.
+/// @param column The index of the column.
+/// @param count Receives the number of names.
+const char* const* getDictionary(int column, int& count) {
+    if (std::strcmp(COLUMNS[column].name, "result") == 0) {
+        count = sizeof(RESULT_NAMES) / sizeof(RESULT_NAMES[0]);
+        return RESULT_NAMES;
+    }
+    count = sizeof(ACTION_NAMES) / sizeof(ACTION_NAMES[0]);
+    return ACTION_NAMES;
+}
+
+/// @brief Writes a column's values for a block.
+template <typename T>
+void writeColumn(QDataStream& out, const std::vector<T>& values) {
+    out.writeRawData(reinterpret_cast<const char*>(values.data()), static_cast<int>(values.size() * sizeof(T)));
+}
+
+/// @brief Reads a column's values for a block.
+/// @return True if every value was read.
+template <typename T>
+bool readColumn(QDataStream& in, std::vector<T>& values, std::size_t rows) {
+    values.resize(rows);
+    int bytes = static_cast<int>(rows * sizeof(T));
+    return in.readRawData(reinterpret_cast<char*>(values.data()), bytes) == bytes;
+}
+
+/// @brief Creates the directory a file will be written to.
+void makeParentDirectory(const QString& path) {
+    QDir().mkpath(QFileInfo(path).absolutePath());
+}
+
+}
+
+const char* getActionName(BasicStrategyChecker::PlayerAction action) {
+    return ACTION_NAMES[static_cast<int>(action)];
+}
+
+const char* getResultName(RoundEngine::GameResult result) {
+    return RESULT_NAMES[static_cast<int>(result)];
+}
+
+void DecisionColumns::clear() {
+    upcards.clear();
+    playerTotals.clear();
+    handKeys.clear();
+    actions.clear();
+    bestActions.clear();
+    trueCounts.clear();
+    results.clear();
+    bets.clear();
+    payouts.clear();
+}
+
+void DecisionColumns::reserve(std::size_t rows) {
+    upcards.reserve(rows);
+    playerTotals.reserve(rows);
+    handKeys.reserve(rows);
+    actions.reserve(rows);
+    bestActions.reserve(rows);
+    trueCounts.reserve(rows);
+    results.reserve(rows);
+    bets.reserve(rows);
+    payouts.reserve(rows);
+}
+
+void DecisionColumns::append(const DecisionRow& row) {
+    upcards.push_back(row.upcard);
+    playerTotals.push_back(row.playerTotal);
+    handKeys.push_back(row.handKey);
+    actions.push_back(static_cast<quint8>(row.action));
+    bestActions.push_back(static_cast<quint8>(row.bestAction));
+    trueCounts.push_back(row.trueCount);
+    results.push_back(static_cast<quint8>(row.result));
+    bets.push_back(row.bet);
+    payouts.push_back(row.payout);
+}
+
+DecisionRow DecisionColumns::getRow(std::size_t index) const {
+    return { upcards[index], playerTotals[index], handKeys[index],
+             static_cast<BasicStrategyChecker::PlayerAction>(actions[index]),
+             static_cast<BasicStrategyChecker::PlayerAction>(bestActions[index]), trueCounts[index],
+             static_cast<RoundEngine::GameResult>(results[index]), bets[index], payouts[index] };
+}
+
+// Columnar files
+
+ColumnarDecisionWriter::ColumnarDecisionWriter() : ok_(false) {}
+
+ColumnarDecisionWriter::~ColumnarDecisionWriter() {
+    finish();
+}
+
+bool ColumnarDecisionWriter::open(const QString& path) {
+    finish();
+    makeParentDirectory(path);
+    file_.setFileName(path);
+    if (!file_.open(QIODevice::WriteOnly))
+        return false;
+    buffer_.clear();
+    buffer_.reserve(BLOCK_ROWS);
+
+    QDataStream out(&file_);
+    out << FILE_MAGIC << FILE_VERSION;
+    out.writeRawData(reinterpret_cast<const char*>(&BYTE_ORDER_MARK), sizeof(BYTE_ORDER_MARK));
+    int columnCount = sizeof(COLUMNS) / sizeof(COLUMNS[0]);
+    out << static_cast<quint8>(columnCount);
+    for (int i = 0; i < columnCount; ++i) {
+        writeName(out, COLUMNS[i].name);
+        out << static_cast<quint8>(COLUMNS[i].type);
+        if (COLUMNS[i].type == ColumnType::Dictionary) {
+            int count;
+            const char* const* names = getDictionary(i, count);
+            out << static_cast<quint8>(count);
+            for (int code = 0; code < count; ++code)
+                writeName(out, names[code]);
+        }
+    }
+    ok_ = out.status() == QDataStream::Ok;
+    return ok_;
+}
+
+void ColumnarDecisionWriter::write(const DecisionRow& row) {
+    if (!file_.isOpen())
+        return;
+    buffer_.append(row);
+    if (buffer_.size() == BLOCK_ROWS)
+        writeBlock();
+}
+
+bool ColumnarDecisionWriter::finish() {
+    if (!file_.isOpen())
+        return false;
+    if (buffer_.size() > 0)
+        writeBlock();
+    file_.close();
+    return ok_;
+}
+
+bool ColumnarDecisionWriter::writeBlock() {
+    QDataStream out(&file_);
+    out << static_cast<quint32>(buffer_.size());
+    writeColumn(out, buffer_.upcards);
+    writeColumn(out, buffer_.playerTotals);
+    writeColumn(out, buffer_.handKeys);
+    writeColumn(out, buffer_.actions);
+    writeColumn(out, buffer_.bestActions);
+    writeColumn(out, buffer_.trueCounts);
+    writeColumn(out, buffer_.results);
+    writeColumn(out, buffer_.bets);
+    writeColumn(out, buffer_.payouts);
+    buffer_.clear();
+    ok_ = ok_ && out.status() == QDataStream::Ok;
+    return ok_;
+}
+
+bool ColumnarDecisionReader::open(const QString& path) {
+    file_.close();
+    file_.setFileName(path);
+    if (!file_.open(QIODevice::ReadOnly))
+        return false;
+
+    // Only files with exactly this build's columns are read
+    QDataStream in(&file_);
+    quint32 magic;
+    quint16 version;
+    quint32 byteOrder;
+    quint8 columnCount;
+    in >> magic >> version;
+    in.readRawData(reinterpret_cast<char*>(&byteOrder), sizeof(byteOrder));
+    in >> columnCount;
+    if (in.status() != QDataStream::Ok || magic != ColumnarDecisionWriter::FILE_MAGIC
+        || version != ColumnarDecisionWriter::FILE_VERSION || byteOrder != BYTE_ORDER_MARK
+        || columnCount != sizeof(COLUMNS) / sizeof(COLUMNS[0]))
+        return false;
+
+    for (int i = 0; i < columnCount; ++i) {
+        quint8 type;
+        if (!readName(in, COLUMNS[i].name))
+            return false;
+        in >> type;
+        if (type != static_cast<quint8>(COLUMNS[i].type))
+            return false;
+        if (COLUMNS[i].type == ColumnType::Dictionary) {
+            int count;
+            const char* const* names = getDictionary(i, count);
+            quint8 fileCount;
+            in >> fileCount;
+            if (fileCount != count)
+                return false;
+            for (int code = 0; code < count; ++code) {
+                if (!readName(in, names[code]))
+                    return false;
+            }
+        }
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+bool ColumnarDecisionReader::readBlock(DecisionColumns& columns) {
+    if (!file_.isOpen())
+        return false;
+
+    QDataStream in(&file_);
+    quint32 rows;
+    in >> rows;
+    if (in.status() != QDataStream::Ok || rows == 0 || rows > ColumnarDecisionWriter::BLOCK_ROWS)
+        return false;
+    return readColumn(in, columns.upcards, rows) && readColumn(in, columns.playerTotals, rows)
+        && readColumn(in, columns.handKeys, rows) && readColumn(in, columns.actions, rows)
+        && readColumn(in, columns.bestActions, rows) && readColumn(in, columns.trueCounts, rows)
+        && readColumn(in, columns.results, rows) && readColumn(in, columns.bets, rows)
+        && readColumn(in, columns.payouts, rows);
+}
+
+// CSV files
+
+CsvDecisionWriter::CsvDecisionWriter() {}
+
+CsvDecisionWriter::~CsvDecisionWriter() {
+    finish();
+}
+
+bool CsvDecisionWriter::open(const QString& path) {
+    finish();
+    makeParentDirectory(path);
+    file_.setFileName(path);
+    if (!file_.open(QIODevice::WriteOnly))
+        return false;
+    out_.setDevice(&file_);
+    for (std::size_t i = 0; i < sizeof(COLUMNS) / sizeof(COLUMNS[0]); ++i)
+        out_ << (i == 0 ? "" : ",") << COLUMNS[i].name;
+    out_ << "\n";
+    return true;
+}
+
+void CsvDecisionWriter::write(const DecisionRow& row) {
+    if (!file_.isOpen())
+        return;
+    out_ << static_cast<int>(row.upcard) << ',' << static_cast<int>(row.playerTotal) << ','
+         << static_cast<int>(row.handKey) << ',' << getActionName(row.action) << ','
+         << getActionName(row.bestAction) << ',' << static_cast<int>(row.trueCount) << ','
+         << getResultName(row.result) << ',' << row.bet << ',' << row.payout << '\n';
+}
+
+bool CsvDecisionWriter::finish() {
+    if (!file_.isOpen())
+        return false;
+    out_.flush();
+    out_.setDevice(nullptr);
+    file_.close();
+    return true;
+}
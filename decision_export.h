@@ -0,0 +1,183 @@
+#ifndef DECISION_EXPORT_H
+#define DECISION_EXPORT_H
+
+#include <vector>
+#include <QFile>
+#include <QString>
+#include <QTextStream>
+#include <QtGlobal>
+#include "basic_strategy_checker.h"
+#include "round_engine.h"
+
+/// @brief One decision the player made, with the outcome of the hand it was made on.
+struct DecisionRow {
+    /// @brief The value of the dealer's upcard, from 2 to 11 (ace).
+    quint8 upcard;
+
+    /// @brief The value of the player's hand when the decision was made.
+    quint8 playerTotal;
+
+    /// @brief The hand key of the player's hand (see BasicStrategyChecker::getHandKey),
+    /// which with the upcard picks out the strategy table cell.
+    quint8 handKey;
+
+    /// @brief The action the player took.
+    BasicStrategyChecker::PlayerAction action;
+
+    /// @brief The action the game recommended.
+    BasicStrategyChecker::PlayerAction bestAction;
+
+    /// @brief The Hi-Lo true count, rounded down.
+    qint8 trueCount;
+
+    /// @brief The result of the hand.
+    RoundEngine::GameResult result;
+
+    /// @brief The final bet on the hand, including any double.
+    qint32 bet;
+
+    /// @brief The amount paid to the player for the hand, including the bet.
+    qint32 payout;
+};
+
+/// @brief Receives decisions as they are captured, such as a file writer.
+class DecisionSink {
+public:
+    virtual ~DecisionSink() = default;
+
+    /// @brief Adds a decision.
+    virtual void write(const DecisionRow& row) = 0;
+
+    /// @brief Writes out anything buffered and closes the output.
+    /// @return True if everything was written.
+    virtual bool finish() = 0;
+};
+
+/// @brief A block of decisions stored column by column: the rows' values of each field are
+/// contiguous, so a query over a few columns reads only those columns. Enums are stored as
+/// their codes, which the file header maps back to names.
+struct DecisionColumns {
+    std::vector<quint8> upcards;
+    std::vector<quint8> playerTotals;
+    std::vector<quint8> handKeys;
+    std::vector<quint8> actions;
+    std::vector<quint8> bestActions;
+    std::vector<qint8> trueCounts;
+    std::vector<quint8> results;
+    std::vector<qint32> bets;
+    std::vector<qint32> payouts;
+
+    /// @brief Gets the number of rows.
+    std::size_t size() const { return upcards.size(); }
+
+    /// @brief Removes every row, keeping the memory allocated.
+    void clear();
+
+    /// @brief Reserves memory for the given number of rows.
+    void reserve(std::size_t rows);
+
+    /// @brief Adds a row.
+    void append(const DecisionRow& row);
+
+    /// @brief Gets a row.
+    DecisionRow getRow(std::size_t index) const;
+};
+
+/// @brief Streams decisions to a columnar file. Rows are buffered into blocks of
+/// BLOCK_ROWS, and each full block is written column by column, so memory use is bounded
+/// by one block however many rows are written.
+///
+/// The file starts with a header naming each column and its type, with the names of every
+/// code of the dictionary-encoded (enum) columns. Blocks follow, each a row count and then
+/// every column's values for those rows. Values are in the writing machine's byte order,
+/// which the header records.
+class ColumnarDecisionWriter : public DecisionSink {
+public:
+    /// @brief The first four bytes of a columnar decision file ("BJCX").
+    static constexpr quint32 FILE_MAGIC = 0x424A4358;
+
+    /// @brief The version of the file format.
+    static constexpr quint16 FILE_VERSION = 1;
+
+    /// @brief The number of rows in each full block.
+    static constexpr int BLOCK_ROWS = 1 << 16;
+
+    /// @brief Creates a writer with no file open.
+    ColumnarDecisionWriter();
+
+    /// @brief Finishes the file, if one is open.
+    ~ColumnarDecisionWriter() override;
+
+    /// @brief Creates (or replaces) a file and writes its header.
+    /// @param path The path of the file. Directories are created as needed.
+    /// @return True if the file was created.
+    bool open(const QString& path);
+
+    void write(const DecisionRow& row) override;
+
+    bool finish() override;
+
+private:
+    /// @brief Writes the buffered rows as a block and clears the buffer.
+    bool writeBlock();
+
+    /// @brief The open file.
+    QFile file_;
+
+    /// @brief The rows not yet written.
+    DecisionColumns buffer_;
+
+    /// @brief False once a write has failed.
+    bool ok_;
+};
+
+/// @brief Reads a columnar decision file one block at a time.
+class ColumnarDecisionReader {
+public:
+    /// @brief Opens a file and reads its header.
+    /// @return True if the file is a columnar decision file this build can read.
+    bool open(const QString& path);
+
+    /// @brief Reads the next block, replacing the contents of columns.
+    /// @return True if a block was read; false at the end of the file (or at a block
+    /// left incomplete by a crash).
+    bool readBlock(DecisionColumns& columns);
+
+private:
+    /// @brief The open file.
+    QFile file_;
+};
+
+/// @brief Streams decisions to a CSV file with a header row, writing enums by name.
+class CsvDecisionWriter : public DecisionSink {
+public:
+    /// @brief Creates a writer with no file open.
+    CsvDecisionWriter();
+
+    /// @brief Finishes the file, if one is open.
+    ~CsvDecisionWriter() override;
+
+    /// @brief Creates (or replaces) a file and writes the header row.
+    /// @param path The path of the file. Directories are created as needed.
+    /// @return True if the file was created.
+    bool open(const QString& path);
+
+    void write(const DecisionRow& row) override;
+
+    bool finish() override;
+
+private:
+    /// @brief The open file.
+    QFile file_;
+
+    /// @brief Formats rows into the file.
+    QTextStream out_;
+};
+
+/// @brief Gets the name of a player action, as written in decision files.
+const char* getActionName(BasicStrategyChecker::PlayerAction action);
+
+/// @brief Gets the name of a hand result, as written in decision files.
+const char* getResultName(RoundEngine::GameResult result);
+
+#endif // DECISION_EXPORT_H
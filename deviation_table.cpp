@@ -0,0 +1,145 @@
+#include "deviation_table.h"
+
+namespace {
+
+using PlayerAction = BasicStrategyChecker::PlayerAction;
+using MoveChain = BasicStrategyChecker::MoveChain;
+
+/// @brief Returns true if an action can always be made.
+bool isAlwaysPlayable(PlayerAction action) {
+    return action == PlayerAction::Hit || action == PlayerAction::Stand;
+}
+
+/// @brief Gets the moves for playing an action in place of the base moves, which do not
+/// surrender.
+MoveChain deviateTo(MoveChain base, PlayerAction action) {
+    if (isAlwaysPlayable(action))
+        return MoveChain { action, action, action };
+    return MoveChain { action, base.best, base.second };
+}
+
+/// @brief Gets the base moves with an action taken out.
+MoveChain withoutAction(MoveChain base, PlayerAction action) {
+    PlayerAction moves[3] { base.best, base.second, base.third };
+    PlayerAction kept[3] {};
+    int length = 0;
+    for (PlayerAction move : moves) {
+        if (move != action)
+            kept[length++] = move;
+    }
+    for (int i = length; i < 3; ++i)
+        kept[i] = length > 0 ? kept[length - 1] : PlayerAction::Hit;
+    return MoveChain { kept[0], kept[1], kept[2] };
+}
+
+/// @brief Gets how to play a hand when not surrendering, from moves that may surrender
+/// first. A surrender later in the moves, as a fallback, is kept.
+MoveChain withoutSurrenderFirst(MoveChain moves) {
+    return moves.best == PlayerAction::Surrender ? withoutAction(moves, PlayerAction::Surrender) : moves;
+}
+
+/// @brief Gets moves that surrender first, then play as given.
+MoveChain surrenderFirst(MoveChain play) {
+    return MoveChain { PlayerAction::Surrender, play.best, play.second };
+}
+
+/// @brief Makes an index for a hard total.
+DeviationTable::Index hard(int total, int upcard, PlayerAction action, int trueCount, bool atOrAbove = true) {
+    return DeviationTable::Index { BasicStrategyChecker::getHardTotalKey(total), upcard, action, trueCount, atOrAbove };
+}
+
+}
+
+DeviationTable::DeviationTable(const BasicStrategyChecker& base) :
+    base_(base)
+{
+    // Split each cell's base moves into whether to surrender and how to play otherwise
+    for (int handKey = 0; handKey < BasicStrategyChecker::HAND_KEY_COUNT; ++handKey) {
+        for (int upcardColumn = 0; upcardColumn < 10; ++upcardColumn) {
+            MoveChain moves = base_.getMoves(handKey, upcardColumn);
+            bool surrenders = moves.best == PlayerAction::Surrender;
+            MoveChain play = withoutSurrenderFirst(moves);
+
+            Entry& entry = entries_[handKey][upcardColumn];
+            entry = Entry { { { play, play }, {} }, 0, static_cast<qint8>(surrenders ? 0 : 1), 0, 1 };
+            updateSurrenderMoves(entry);
+        }
+    }
+}
+
+DeviationTable DeviationTable::forRuleset(const BasicStrategyChecker& base, const Ruleset& rules) {
+    DeviationTable table(base);
+    table.addIndices(illustrious18(rules.dealerHitsSoft17));
+    if (rules.surrenderAllowed)
+        table.addIndices(fab4(rules.dealerHitsSoft17));
+    return table;
+}
+
+QVector<DeviationTable::Index> DeviationTable::illustrious18(bool dealerHitsSoft17) {
+    int pairOfTens = BasicStrategyChecker::getPairKey(10);
+    return {
+        hard(16, 10, PlayerAction::Stand, 0),
+        hard(15, 10, PlayerAction::Stand, 4),
+        Index { pairOfTens, 5, PlayerAction::Split, 5, true },
+        Index { pairOfTens, 6, PlayerAction::Split, 4, true },
+        hard(10, 10, PlayerAction::Double, 4),
+        hard(12, 3, PlayerAction::Stand, 2),
+        hard(12, 2, PlayerAction::Stand, 3),
+        hard(11, 11, PlayerAction::Double, dealerHitsSoft17 ? -1 : 1),
+        hard(9, 2, PlayerAction::Double, 1),
+        hard(10, 11, PlayerAction::Double, dealerHitsSoft17 ? 3 : 4),
+        hard(9, 7, PlayerAction::Double, 3),
+        hard(16, 9, PlayerAction::Stand, 5),
+        hard(13, 2, PlayerAction::Hit, -1, false),
+        hard(12, 4, PlayerAction::Hit, 0, false),
+        hard(12, 5, PlayerAction::Hit, -2, false),
+        hard(12, 6, PlayerAction::Hit, -1, false),
+        hard(13, 3, PlayerAction::Hit, -2, false)
+    };
+}
+
+QVector<DeviationTable::Index> DeviationTable::fab4(bool dealerHitsSoft17) {
+    return {
+        hard(14, 10, PlayerAction::Surrender, 3),
+        hard(15, 10, PlayerAction::Surrender, 0),
+        hard(15, 9, PlayerAction::Surrender, 2),
+        hard(15, 11, PlayerAction::Surrender, dealerHitsSoft17 ? -1 : 1)
+    };
+}
+
+void DeviationTable::addIndex(const Index& index) {
+    int upcardColumn = index.upcard - 2;
+    Entry& entry = entries_[index.handKey][upcardColumn];
+
+    // The index applies when sign * trueCount >= threshold: for "at or above n" that is
+    // trueCount >= n, and for "below n" it is -trueCount >= 1 - n
+    qint8 sign = index.atOrAbove ? 1 : -1;
+    qint8 threshold = static_cast<qint8>(index.atOrAbove ? index.trueCount : 1 - index.trueCount);
+
+    if (index.action == PlayerAction::Surrender) {
+        // Surrender where the index applies, whatever basic strategy does
+        entry.surrenderSign = sign;
+        entry.surrenderThreshold = threshold;
+        return;
+    }
+
+    // Play the action where the index applies, and not where it does not: if basic
+    // strategy already plays it, the index is where to stop
+    MoveChain base = withoutSurrenderFirst(base_.getMoves(index.handKey, upcardColumn));
+    bool basePlays = base.best == index.action;
+    entry.moves[0][1] = basePlays ? base : deviateTo(base, index.action);
+    entry.moves[0][0] = basePlays ? withoutAction(base, index.action) : base;
+    entry.playSign = sign;
+    entry.playThreshold = threshold;
+    updateSurrenderMoves(entry);
+}
+
+void DeviationTable::updateSurrenderMoves(Entry& entry) {
+    entry.moves[1][0] = surrenderFirst(entry.moves[0][0]);
+    entry.moves[1][1] = surrenderFirst(entry.moves[0][1]);
+}
+
+void DeviationTable::addIndices(const QVector<Index>& indices) {
+    for (const Index& index : indices)
+        addIndex(index);
+}
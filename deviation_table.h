@@ -0,0 +1,113 @@
+#ifndef DEVIATION_TABLE_H
+#define DEVIATION_TABLE_H
+
+#include <QVector>
+#include <QtGlobal>
+#include "basic_strategy_checker.h"
+#include "card.h"
+#include "hand.h"
+#include "ruleset.h"
+
+/// @brief True-count index plays (deviations) layered on top of a BasicStrategyChecker.
+///
+/// Each cell of the strategy table (a hand key against an upcard) holds up to two indices:
+/// one for whether to surrender, and one for how to play the hand otherwise, since the
+/// Fab 4 and the Illustrious 18 can both have an index for the same hand (e.g., 15
+/// against 10). The MoveChain for each combination of the two is worked out when an index
+/// is added, so a lookup is two comparisons of the true count against the cell's
+/// thresholds.
+class DeviationTable {
+public:
+    /// @brief An index play: play an action instead of basic strategy when the true count
+    /// is at or above (or below) a threshold.
+    struct Index {
+        /// @brief The hand key of the hand (see BasicStrategyChecker::getHandKey).
+        int handKey;
+
+        /// @brief The value of the dealer's upcard, from 2 to 11 (ace).
+        int upcard;
+
+        /// @brief The action to play when the index applies.
+        BasicStrategyChecker::PlayerAction action;
+
+        /// @brief The true count the index is measured against.
+        int trueCount;
+
+        /// @brief True if the index applies at or above trueCount; false if it applies
+        /// below it.
+        bool atOrAbove;
+    };
+
+    /// @brief Creates a table with no indices, which always plays basic strategy.
+    /// @param base The basic strategy to deviate from.
+    explicit DeviationTable(const BasicStrategyChecker& base = BasicStrategyChecker());
+
+    /// @brief Creates a table with the Illustrious 18 (less insurance, which the game does
+    /// not offer) and, if the rules allow surrender, the Fab 4 surrender indices.
+    /// @param base The basic strategy to deviate from.
+    /// @param rules The rules of the game.
+    static DeviationTable forRuleset(const BasicStrategyChecker& base, const Ruleset& rules);
+
+    /// @brief Gets the Illustrious 18 hard-total and pair indices for the Hi-Lo count.
+    /// @param dealerHitsSoft17 True to use the H17 indices for 11 and 10 against an ace.
+    static QVector<Index> illustrious18(bool dealerHitsSoft17);
+
+    /// @brief Gets the Fab 4 surrender indices for the Hi-Lo count.
+    /// @param dealerHitsSoft17 True to use the H17 index for 15 against an ace.
+    static QVector<Index> fab4(bool dealerHitsSoft17);
+
+    /// @brief Adds an index play. A surrender index replaces the cell's surrender index,
+    /// and any other index replaces the cell's play index, so the two are kept apart; e.g.,
+    /// with "stand on 15 against 10 at +4" and "surrender 15 against 10 at 0", the player
+    /// surrenders from 0, and stands from +4 when surrender cannot be made. If basic
+    /// strategy already plays the index's action, the index also means to stop playing it
+    /// on the other side of the threshold.
+    /// @param index The index to add.
+    void addIndex(const Index& index);
+
+    /// @brief Adds several index plays, in order.
+    void addIndices(const QVector<Index>& indices);
+
+    /// @brief Gets the best, second-best, and third-best moves for a hand at a true count.
+    /// @param hand The player's hand, which must not be bust.
+    /// @param dealerUpcard The dealer's upcard.
+    /// @param trueCount The true count, rounded down to an integer.
+    /// @return The moves, with any index play for the hand applied.
+    BasicStrategyChecker::MoveChain getMoves(const Hand& hand, Card dealerUpcard, int trueCount) const {
+        int handKey = BasicStrategyChecker::getHandKey(hand);
+        int upcardColumn = BasicStrategyChecker::getUpcardIndex(dealerUpcard);
+        const Entry& entry = entries_[handKey][upcardColumn];
+        bool surrenders = entry.surrenderSign * trueCount >= entry.surrenderThreshold;
+        bool plays = entry.playSign * trueCount >= entry.playThreshold;
+        return entry.moves[surrenders][plays];
+    }
+
+    /// @brief Gets the basic strategy the table deviates from.
+    const BasicStrategyChecker& getBase() const { return base_; }
+
+private:
+    /// @brief The index plays for one cell. The player surrenders when surrenderSign *
+    /// trueCount is at least surrenderThreshold, and the play index applies when playSign *
+    /// trueCount is at least playThreshold. Without an index, the sign is 0 and the
+    /// threshold is 0 (always) or 1 (never).
+    struct Entry {
+        /// @brief The moves, by whether the player surrenders and then by whether the play
+        /// index applies.
+        BasicStrategyChecker::MoveChain moves[2][2];
+        qint8 surrenderSign;
+        qint8 surrenderThreshold;
+        qint8 playSign;
+        qint8 playThreshold;
+    };
+
+    /// @brief Sets the moves of a cell's surrendering entries from its other entries.
+    static void updateSurrenderMoves(Entry& entry);
+
+    /// @brief The basic strategy to deviate from.
+    BasicStrategyChecker base_;
+
+    /// @brief The index plays for each hand key and upcard column.
+    Entry entries_[BasicStrategyChecker::HAND_KEY_COUNT][10];
+};
+
+#endif // DEVIATION_TABLE_H
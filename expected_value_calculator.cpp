@@ -0,0 +1,262 @@
+#include "expected_value_calculator.h"
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <QtGlobal>
+
+namespace {
+
+/// @brief The value of an action that cannot be taken.
+constexpr double NOT_ALLOWED = std::numeric_limits<double>::quiet_NaN();
+
+/// @brief Solves one player hand against the dealer for a fixed starting hand. Each state
+/// is identified by the cards the player has drawn since the starting hand, packed four
+/// bits per value index, which also determines the player's total and the composition
+/// the dealer draws from.
+class PlayerSolver {
+public:
+    /// @brief Creates a solver for a starting hand.
+    /// @param rules The rules of the game.
+    /// @param upcardIndex The value index of the dealer's upcard.
+    /// @param composition The cards the player and dealer draw from.
+    /// @param hardTotal The starting hand's total with aces counted as 1.
+    /// @param hasAce True if the starting hand holds an ace.
+    /// @param dealerCache The cache of dealer outcome probabilities to use.
+    PlayerSolver(const Ruleset& rules, int upcardIndex, const Composition& composition,
+                 int hardTotal, bool hasAce, DealerOutcomeCache& dealerCache) :
+        rules_(rules), upcardIndex_(upcardIndex), composition_(composition),
+        hardTotal_(hardTotal), hasAce_(hasAce), dealerCache_(dealerCache) {}
+
+    /// @brief Gets the expected value of standing on the starting hand.
+    double stand() {
+        return standOn(valueOf(hardTotal_, hasAce_));
+    }
+
+    /// @brief Gets the expected value of hitting the starting hand.
+    double hit() {
+        return hitFrom(hardTotal_, hasAce_, 0);
+    }
+
+    /// @brief Gets the expected value of doubling the starting hand.
+    double doubleDown() {
+        return doubleFrom(hardTotal_, hasAce_);
+    }
+
+    /// @brief Gets the expected value of each split hand, where the starting hand is the
+    /// single card that was split.
+    /// @param canDouble True if the split hands may be doubled.
+    /// @param canHit True if the split hands may be hit.
+    /// @param canResplit True if the split hands may be split again.
+    double splitHand(bool canDouble, bool canHit, bool canResplit) {
+        int pairIndex = hasAce_ ? 0 : hardTotal_ - 1;
+        double otherValue = 0;
+        double pairProbability = 0;
+        double pairValue = 0;
+
+        for (int i = 0; i < Composition::VALUE_COUNT; ++i) {
+            int count = composition_.counts[i];
+            if (count == 0) continue;
+
+            double p = static_cast<double>(count) / composition_.total;
+            int hardTotal = hardTotal_ + Composition::valueOf(i);
+            bool hasAce = hasAce_ || i == 0;
+            quint64 key = keyFor(0, i);
+            composition_.remove(i);
+
+            double value = standOn(valueOf(hardTotal, hasAce));
+            if (canHit && valueOf(hardTotal, hasAce) < 21) {
+                value = qMax(value, bestFrom(hardTotal, hasAce, key));
+                if (canDouble)
+                    value = qMax(value, doubleFrom(hardTotal, hasAce));
+            }
+            composition_.add(i);
+
+            if (i == pairIndex && canResplit) {
+                pairProbability = p;
+                pairValue = value;
+            }
+            else {
+                otherValue += p * value;
+            }
+        }
+
+        // A resplit pair is worth two split hands, so if resplitting is best, the value
+        // of a split hand x solves x = otherValue + pairProbability * 2x
+        double value = otherValue + pairProbability * pairValue;
+        if (pairProbability > 0 && pairProbability < 0.5) {
+            double resplitValue = otherValue / (1 - 2 * pairProbability);
+            if (2 * resplitValue > pairValue)
+                value = resplitValue;
+        }
+        return value;
+    }
+
+private:
+    /// @brief Gets the value of a hand from its hard total.
+    static int valueOf(int hardTotal, bool hasAce) {
+        return hasAce && hardTotal <= 11 ? hardTotal + 10 : hardTotal;
+    }
+
+    /// @brief Adds a card of the given value index to a state's key.
+    static quint64 keyFor(quint64 key, int index) {
+        return key + (1ull << (4 * index));
+    }
+
+    /// @brief Gets the expected value of standing on the given total.
+    double standOn(int total) {
+        if (total > 21) return -1;
+
+        const auto& p = dealerCache_.get(upcardIndex_, composition_, rules_).probabilities;
+        double value = p[DealerOutcomes::Bust] - p[DealerOutcomes::Blackjack];
+        if (!rules_.pushOnDealer22)
+            value += p[DealerOutcomes::Bust22];
+        for (int dealerTotal = 17; dealerTotal <= 21; ++dealerTotal) {
+            double probability = p[DealerOutcomes::Total17 + dealerTotal - 17];
+            if (total > dealerTotal)
+                value += probability;
+            else if (total < dealerTotal)
+                value -= probability;
+        }
+        return value;
+    }
+
+    /// @brief Gets the expected value of a state when the player stands or hits,
+    /// whichever is better. Hands of 21 always stand.
+    double bestFrom(int hardTotal, bool hasAce, quint64 key) {
+        int total = valueOf(hardTotal, hasAce);
+        if (total > 21) return -1;
+        if (total == 21) return standOn(total);
+
+        auto found = bestMemo_.find(key);
+        if (found != bestMemo_.end())
+            return found->second;
+
+        // Standing on 11 or less can only win if the dealer busts. Hitting and then
+        // standing wins in the same cases (a random card removed from the composition
+        // leaves the dealer's chance to bust unchanged on average) and possibly more, so
+        // the dealer's hand does not need to be solved for these states.
+        double value = hitFrom(hardTotal, hasAce, key);
+        if (total > 11)
+            value = qMax(value, standOn(total));
+        bestMemo_.emplace(key, value);
+        return value;
+    }
+
+    /// @brief Gets the expected value of hitting a state, then playing on perfectly.
+    double hitFrom(int hardTotal, bool hasAce, quint64 key) {
+        double value = 0;
+        for (int i = 0; i < Composition::VALUE_COUNT; ++i) {
+            int count = composition_.counts[i];
+            if (count == 0) continue;
+
+            double p = static_cast<double>(count) / composition_.total;
+            composition_.remove(i);
+            value += p * bestFrom(hardTotal + Composition::valueOf(i), hasAce || i == 0, keyFor(key, i));
+            composition_.add(i);
+        }
+        return value;
+    }
+
+    /// @brief Gets the expected value of doubling a state and standing on the card drawn.
+    double doubleFrom(int hardTotal, bool hasAce) {
+        double value = 0;
+        for (int i = 0; i < Composition::VALUE_COUNT; ++i) {
+            int count = composition_.counts[i];
+            if (count == 0) continue;
+
+            double p = static_cast<double>(count) / composition_.total;
+            composition_.remove(i);
+            value += p * standOn(valueOf(hardTotal + Composition::valueOf(i), hasAce || i == 0));
+            composition_.add(i);
+        }
+        return 2 * value;
+    }
+
+    /// @brief The rules of the game.
+    const Ruleset& rules_;
+
+    /// @brief The value index of the dealer's upcard.
+    int upcardIndex_;
+
+    /// @brief The cards left to draw from, updated as the recursion draws them.
+    Composition composition_;
+
+    /// @brief The starting hand's total with aces counted as 1.
+    int hardTotal_;
+
+    /// @brief True if the starting hand holds an ace.
+    bool hasAce_;
+
+    /// @brief The cache of dealer outcome probabilities, shared across solvers.
+    DealerOutcomeCache& dealerCache_;
+
+    /// @brief The value of standing or hitting, whichever is better, for each state.
+    std::unordered_map<quint64, double> bestMemo_;
+};
+
+}
+
+double ExpectedValueCalculator::ActionValues::valueOf(BasicStrategyChecker::PlayerAction action) const {
+    switch (action) {
+    case BasicStrategyChecker::PlayerAction::Hit:
+        return hit;
+    case BasicStrategyChecker::PlayerAction::Stand:
+        return stand;
+    case BasicStrategyChecker::PlayerAction::Double:
+        return doubleDown;
+    case BasicStrategyChecker::PlayerAction::Split:
+    case BasicStrategyChecker::PlayerAction::SplitIfDas:
+        return split;
+    case BasicStrategyChecker::PlayerAction::Surrender:
+        return surrender;
+    }
+    return NOT_ALLOWED;
+}
+
+BasicStrategyChecker::PlayerAction ExpectedValueCalculator::ActionValues::getBestAction() const {
+    using PlayerAction = BasicStrategyChecker::PlayerAction;
+
+    PlayerAction best = PlayerAction::Stand;
+    for (PlayerAction action : { PlayerAction::Hit, PlayerAction::Double, PlayerAction::Split,
+                                 PlayerAction::Surrender }) {
+        // NaN compares false, so actions that cannot be taken are never chosen
+        if (valueOf(action) > valueOf(best))
+            best = action;
+    }
+    return best;
+}
+
+ExpectedValueCalculator::ExpectedValueCalculator(const Ruleset& rules) :
+    rules_(rules)
+{}
+
+ExpectedValueCalculator::ActionValues ExpectedValueCalculator::evaluate(const Hand& hand, Card dealerUpcard,
+                                                                        const Composition& unseen,
+                                                                        bool isSplitHand) const {
+    int upcardIndex = Composition::indexOf(dealerUpcard);
+    bool isSplitAce = isSplitHand && hand.size() > 0 && hand[0].rank == Card::Rank::Ace;
+    bool canHit = hand.getValue() < 21 && !(isSplitAce && !rules_.hitSplitAces);
+    bool canDouble = canHit && hand.size() == 2 && (!isSplitHand || rules_.doubleAfterSplit);
+    bool isAcePair = hand.isPair() && hand[0].rank == Card::Rank::Ace;
+    bool canSplit = hand.isPair() && (!isSplitHand || (rules_.resplit && (!isAcePair || rules_.resplitAces)));
+    bool canSurrender = rules_.surrenderAllowed && !isSplitHand && hand.size() == 2;
+
+    PlayerSolver solver(rules_, upcardIndex, unseen, hand.getHardTotal(), hand.hasAce(), dealerCache_);
+    ActionValues values;
+    values.stand = solver.stand();
+    values.hit = canHit ? solver.hit() : NOT_ALLOWED;
+    values.doubleDown = canDouble ? solver.doubleDown() : NOT_ALLOWED;
+    values.surrender = canSurrender ? -0.5 : NOT_ALLOWED;
+    values.split = NOT_ALLOWED;
+
+    if (canSplit) {
+        // Each split hand starts from one of the pair's cards
+        Card pairCard = hand[0];
+        PlayerSolver splitSolver(rules_, upcardIndex, unseen, Composition::valueOf(Composition::indexOf(pairCard)),
+                                 isAcePair, dealerCache_);
+        bool splitHandsCanHit = !isAcePair || rules_.hitSplitAces;
+        bool splitHandsCanResplit = rules_.resplit && (!isAcePair || (rules_.resplitAces && rules_.hitSplitAces));
+        values.split = 2 * splitSolver.splitHand(rules_.doubleAfterSplit, splitHandsCanHit, splitHandsCanResplit);
+    }
+    return values;
+}
@@ -0,0 +1,84 @@
+#ifndef EXPECTED_VALUE_CALCULATOR_H
+#define EXPECTED_VALUE_CALCULATOR_H
+
+#include "basic_strategy_checker.h"
+#include "card.h"
+#include "composition.h"
+#include "dealer_outcome_cache.h"
+#include "hand.h"
+#include "ruleset.h"
+
+/// @brief Computes the exact expected value of each action for a player hand, using the
+/// actual composition of the cards left to be dealt rather than the fixed tables of basic
+/// strategy. Values are in units of the hand's original bet, so standing on a hand that
+/// always wins is worth 1 and surrendering is worth -0.5.
+///
+/// Standing, hitting, and doubling are computed exactly: every sequence of hits is
+/// followed, with each card drawn removed from the composition, and the dealer's hand is
+/// solved again for the composition left after each sequence. Splitting is computed the
+/// same way for each split hand, but assumes the hands draw from the same composition
+/// (ignoring the cards dealt to the other hands), and allows resplitting without limit,
+/// as RoundEngine does.
+///
+/// The dealer's outcome probabilities are kept in a DealerOutcomeCache across calls, so
+/// evaluating the same hand again, or another hand from a nearby composition, mostly reuses
+/// dealer solves already done. A calculator is therefore not safe to use from several
+/// threads at once.
+class ExpectedValueCalculator {
+public:
+    /// @brief The expected value of each action for a hand. Actions that cannot be taken
+    /// with the hand are NaN.
+    struct ActionValues {
+        /// @brief The expected value of standing.
+        double stand;
+
+        /// @brief The expected value of hitting, then playing on perfectly.
+        double hit;
+
+        /// @brief The expected value of doubling, in units of the original bet.
+        double doubleDown;
+
+        /// @brief The expected value of splitting, in units of the original bet, then
+        /// playing each split hand perfectly.
+        double split;
+
+        /// @brief The expected value of surrendering.
+        double surrender;
+
+        /// @brief Gets the expected value of an action.
+        /// @param action One of Hit, Stand, Double, Split, or Surrender.
+        /// @return The expected value, or NaN if the action cannot be taken.
+        double valueOf(BasicStrategyChecker::PlayerAction action) const;
+
+        /// @brief Gets the action with the highest expected value.
+        /// @return One of Hit, Stand, Double, Split, or Surrender.
+        BasicStrategyChecker::PlayerAction getBestAction() const;
+    };
+
+    /// @brief Creates a new ExpectedValueCalculator.
+    /// @param rules The rules of the game.
+    explicit ExpectedValueCalculator(const Ruleset& rules);
+
+    /// @brief Computes the expected value of each action for a hand.
+    /// @param hand The player's hand.
+    /// @param dealerUpcard The dealer's upcard.
+    /// @param unseen The cards that have not been seen by the player; i.e., the cards left
+    /// in the shoe plus the dealer's hole card. The player's cards and the upcard must
+    /// already be removed.
+    /// @param isSplitHand True if the hand was created by splitting.
+    /// @return The expected value of each action.
+    ActionValues evaluate(const Hand& hand, Card dealerUpcard, const Composition& unseen,
+                          bool isSplitHand = false) const;
+
+    /// @brief Gets the cache of dealer outcome probabilities.
+    const DealerOutcomeCache& getDealerCache() const { return dealerCache_; }
+
+private:
+    /// @brief The rules of the game.
+    Ruleset rules_;
+
+    /// @brief The dealer's outcome probabilities computed so far.
+    mutable DealerOutcomeCache dealerCache_;
+};
+
+#endif // EXPECTED_VALUE_CALCULATOR_H
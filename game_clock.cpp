@@ -0,0 +1,67 @@
+#include "game_clock.h"
+#include <cmath>
+#include <QTimer>
+
+int GameClock::scale(int duration) const {
+    return static_cast<int>(std::lround(duration * getTimeScale()));
+}
+
+RealTimeClock& GameClock::getDefault() {
+    static RealTimeClock clock;
+    return clock;
+}
+
+// Real time
+
+RealTimeClock::RealTimeClock(double timeScale) : timeScale_(qMax(0.0, timeScale)) {}
+
+void RealTimeClock::setTimeScale(double timeScale) {
+    timeScale_ = qMax(0.0, timeScale);
+}
+
+void RealTimeClock::post(int delay, QObject* context, std::function<void()> callback) {
+    QTimer::singleShot(scale(delay), context, std::move(callback));
+}
+
+// Virtual time
+
+VirtualClock::VirtualClock() : now_(0) {}
+
+void VirtualClock::post(int delay, QObject* context, std::function<void()> callback) {
+    // Inserting among equal keys places the entry last, so ties keep their order
+    pending_.emplace(now_ + qMax(0, delay), Entry { context, context != nullptr, std::move(callback) });
+}
+
+void VirtualClock::runFirst() {
+    auto first = pending_.begin();
+    now_ = qMax(now_, first->first);
+    Entry entry = std::move(first->second);
+    pending_.erase(first);
+    if (entry.context || !entry.hasContext)
+        entry.callback();
+}
+
+int VirtualClock::advance(qint64 milliseconds) {
+    qint64 end = now_ + qMax<qint64>(0, milliseconds);
+    int run = 0;
+    while (!pending_.empty() && pending_.begin()->first <= end) {
+        runFirst();
+        run++;
+    }
+    now_ = end;
+    return run;
+}
+
+bool VirtualClock::runNext() {
+    if (pending_.empty())
+        return false;
+    runFirst();
+    return true;
+}
+
+int VirtualClock::runUntilIdle(int maxCallbacks) {
+    int run = 0;
+    while (run < maxCallbacks && runNext())
+        run++;
+    return run;
+}
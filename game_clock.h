@@ -0,0 +1,146 @@
+#ifndef GAME_CLOCK_H
+#define GAME_CLOCK_H
+
+#include <functional>
+#include <map>
+#include <QObject>
+#include <QPointer>
+#include <QtGlobal>
+
+class RealTimeClock;
+
+/// @brief Schedules the delayed steps of the game flow: the pauses between dealt cards,
+/// dealer hits, and results. Every delay in BlackjackGame and GameWidget goes through a
+/// clock instead of straight to QTimer, so the flow can be run at another speed, or
+/// stepped by a VirtualClock without waiting at all.
+///
+/// Like QTimer::singleShot, a callback is dropped if its context object is destroyed
+/// before it runs, and callbacks due at the same time run in the order they were
+/// scheduled. Clocks are used from the GUI thread only.
+class GameClock {
+public:
+    virtual ~GameClock() = default;
+
+    /// @brief Calls a function after a delay.
+    /// @param delay The delay, in milliseconds of game time.
+    /// @param context The object the callback belongs to; if it is destroyed first, the
+    /// callback is not called. May be null, in which case the callback always runs.
+    /// @param callback The function to call.
+    void schedule(int delay, QObject* context, std::function<void()> callback) {
+        post(delay, context, std::move(callback));
+    }
+
+    /// @brief Calls a member function after a delay, unless the object is destroyed first.
+    /// @param delay The delay, in milliseconds of game time.
+    /// @param object The object to call the function on.
+    /// @param method The function to call.
+    template <typename T>
+    void schedule(int delay, T* object, void (T::*method)()) {
+        post(delay, object, [object, method]() { (object->*method)(); });
+    }
+
+    /// @brief Gets the factor game time is scaled by to give real time: 1 at normal speed,
+    /// and 0 when nothing waits. Animations are scaled by it to stay in step with the
+    /// game flow.
+    virtual double getTimeScale() const = 0;
+
+    /// @brief Scales a duration of game time to real time, rounding to whole
+    /// milliseconds.
+    int scale(int duration) const;
+
+    /// @brief Gets the clock that runs in real time, shared by every game unless another
+    /// is given.
+    static RealTimeClock& getDefault();
+
+protected:
+    /// @brief Schedules a callback. See schedule.
+    virtual void post(int delay, QObject* context, std::function<void()> callback) = 0;
+};
+
+/// @brief Runs the game in real time, with every delay multiplied by a time scale: 1 is
+/// normal speed, 0.5 twice as fast, and 0 runs each step as soon as the event loop is
+/// free (never synchronously, so steps still happen in order).
+class RealTimeClock : public GameClock {
+public:
+    /// @brief Creates a new RealTimeClock.
+    /// @param timeScale The factor every delay is multiplied by.
+    explicit RealTimeClock(double timeScale = 1);
+
+    /// @brief Sets the factor every delay is multiplied by, from then on.
+    /// @param timeScale The factor, at least 0.
+    void setTimeScale(double timeScale);
+
+    /// @brief Gets the factor every delay is multiplied by.
+    double getTimeScale() const override { return timeScale_; }
+
+protected:
+    void post(int delay, QObject* context, std::function<void()> callback) override;
+
+private:
+    /// @brief The factor every delay is multiplied by.
+    double timeScale_;
+};
+
+/// @brief A clock that only moves when told to, so tests and automation can run the game
+/// flow as fast as the code runs, and get exactly the same order of steps every time.
+/// Advancing runs every callback that falls due, in time order, including callbacks
+/// scheduled by the callbacks themselves. Nothing waits in real time, so animations are
+/// instant (the time scale is 0).
+class VirtualClock : public GameClock {
+public:
+    /// @brief Creates a new VirtualClock at time 0.
+    VirtualClock();
+
+    /// @brief Returns 0: no real time passes.
+    double getTimeScale() const override { return 0; }
+
+    /// @brief Gets the current game time, in milliseconds since the clock was created.
+    qint64 now() const { return now_; }
+
+    /// @brief Moves the clock forward, running every callback due by the new time.
+    /// @param milliseconds The amount of game time to pass.
+    /// @return The number of callbacks run.
+    int advance(qint64 milliseconds);
+
+    /// @brief Moves the clock to the next scheduled callback and runs it.
+    /// @return False if nothing is scheduled.
+    bool runNext();
+
+    /// @brief Runs callbacks until nothing is scheduled, moving the clock to each in turn.
+    /// @param maxCallbacks The most callbacks to run, as a guard against flows that never
+    /// settle.
+    /// @return The number of callbacks run.
+    int runUntilIdle(int maxCallbacks = 100000);
+
+    /// @brief Gets the number of callbacks scheduled and not yet run.
+    int getPendingCount() const { return static_cast<int>(pending_.size()); }
+
+protected:
+    void post(int delay, QObject* context, std::function<void()> callback) override;
+
+private:
+    /// @brief A scheduled callback.
+    struct Entry {
+        /// @brief Becomes null if the context is destroyed.
+        QPointer<QObject> context;
+
+        /// @brief Whether the callback was given a context, so a null context means it
+        /// was destroyed rather than never given.
+        bool hasContext;
+
+        std::function<void()> callback;
+    };
+
+    /// @brief Removes the first scheduled callback and runs it, unless it was given a
+    /// context that is now gone.
+    void runFirst();
+
+    /// @brief The current game time, in milliseconds.
+    qint64 now_;
+
+    /// @brief The scheduled callbacks, by due time. Callbacks due at the same time keep
+    /// the order they were scheduled in.
+    std::multimap<qint64, Entry> pending_;
+};
+
+#endif // GAME_CLOCK_H
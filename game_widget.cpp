@@ -180,6 +180,7 @@ GameWidget::GameWidget(BlackjackGame* game, QWidget *parent)
 
     // Set up CardsView
     cardsView_ = new CardsView(this);
+    cardsView_->setClock(&game_->getClock());
     cardsView_->setGeometry(rect());
     cardsView_->lower();
 
@@ -221,6 +222,25 @@ GameWidget::GameWidget(BlackjackGame* game, QWidget *parent)
     connect(game_, &BlackjackGame::betPlaced, this, &GameWidget::onBetPlaced);
     connect(game_, &BlackjackGame::splitHand, this, &GameWidget::onHandSplit);
 
+    // Hand history. If the file cannot be opened, rounds are simply not recorded.
+    history_.open(HandHistoryWriter::getDefaultPath());
+    connect(game_, &BlackjackGame::roundRecorded, this, [this](const HandHistoryRecord& record) {
+        history_.append(record);
+    });
+
+    // Session log, written as the session is played so it survives a crash. If the file
+    // cannot be created, the session is not saved.
+    sessionLogFile_.open(game_->getSessionLog().getDefaultPath(), game_->getSessionLog());
+
+    // Decision exports, written for the whole session. If a file cannot be created, its
+    // writer ignores the rows.
+    QString decisionPath = DecisionCapture::getDefaultBasePath();
+    decisionFile_.open(decisionPath + ".bjcx");
+    decisionCsv_.open(decisionPath + ".csv");
+    decisionCapture_ = new DecisionCapture(game_, this);
+    decisionCapture_->addSink(&decisionFile_);
+    decisionCapture_->addSink(&decisionCsv_);
+
     // Card deals.
     connect(game, &BlackjackGame::playerCardDealt, this, &GameWidget::onPlayerCardDealt);
     connect(game, &BlackjackGame::dealerCardDealt, this, &GameWidget::onDealerCardDealt);
@@ -247,6 +267,8 @@ GameWidget::GameWidget(BlackjackGame* game, QWidget *parent)
         game_->playerSplit();
     });
     connect(ui_->returnButton, &QPushButton::clicked, this, &GameWidget::onReturnToMainMenu);
+    connect(this, &GameWidget::returnToMainMenu, this, &GameWidget::saveSessionLog);
+    connect(this, &GameWidget::returnToMainMenu, this, &GameWidget::finishDecisionExports);
     connect(ui_->surrenderButton, &QPushButton::clicked, this, [this]{
         checkBasicStrategy(BasicStrategyChecker::PlayerAction::Surrender);
         game_->playerSurrender();
@@ -307,7 +329,7 @@ QString GameWidget::generateStrategyExplanation(BasicStrategyChecker::PlayerActi
         handDescription = QString("a pair of %1").arg(rankName);
     } else {
         // Not a pair - check if soft or hard
-        int handValue = BlackjackGame::getHandValue(const_cast<QVector<Card>&>(hand));
+        int handValue = BlackjackGame::getHandValue(hand);
         bool isSoft = BlackjackGame::isSoftHand(hand);
         QString handType = isSoft ? "soft" : "hard";
         handDescription = QString("%1 %2").arg(handType).arg(handValue);
@@ -338,6 +360,15 @@ bool GameWidget::checkBasicStrategy(BasicStrategyChecker::PlayerAction chosenAct
     messageBox.setWindowTitle("Basic Strategy Mistake");
     messageBox.setText(QString("You chose to %1, but %2.")
                    .arg(chosenStr.toLower(), explanation));
+
+    // Compare both plays using the cards actually left in the shoe
+    ExpectedValueCalculator::ActionValues values = game_->getActionValues();
+    BasicStrategyChecker::PlayerAction exactBest = values.getBestAction();
+    messageBox.setInformativeText(QString("With the cards left in this shoe, the best play is to %1 "
+                                          "(expected value %2 per bet). Your choice is worth %3.")
+                                      .arg(actionToString(exactBest).toLower())
+                                      .arg(values.valueOf(exactBest), 0, 'f', 3)
+                                      .arg(values.valueOf(chosenAction), 0, 'f', 3));
     messageBox.setIcon(QMessageBox::Warning);
     messageBox.setStandardButtons(QMessageBox::Ok);
     messageBox.exec();
@@ -382,7 +413,7 @@ void GameWidget::onRoundEnded(BlackjackGame::GameResult result, int payout,
     updateBalance(payout, 1000, 500);
 
     if (balance_ == 0) {
-        timer_.singleShot(2000, this, [this]() {
+        game_->getClock().schedule(NEXT_ROUND_DELAY, this, [this]() {
             QMessageBox msgBox(this);
             msgBox.setWindowTitle("YOU HAVE NO MONEY!");
             msgBox.setText("Do you want to restart?");
@@ -408,8 +439,10 @@ void GameWidget::onRoundEnded(BlackjackGame::GameResult result, int payout,
 
     // Only reset game after the LAST hand is processed
     if (handIndex == totalHands - 1) {
+        saveSessionLog();
+
         // Add extra delay after last hand before reset
-        timer_.singleShot(2000, this, &GameWidget::resetGame);
+        game_->getClock().schedule(NEXT_ROUND_DELAY, this, &GameWidget::resetGame);
     }
 
     // Remove split hand selection.
@@ -636,6 +669,15 @@ void GameWidget::resizeEvent(QResizeEvent* event) {
     updateCountingLabel();
 }
 
+void GameWidget::saveSessionLog() {
+    sessionLogFile_.write(game_->getSessionLog());
+}
+
+void GameWidget::finishDecisionExports() {
+    decisionFile_.finish();
+    decisionCsv_.finish();
+}
+
 void GameWidget::resetGame() {
     // Reset cardsView
     cardsView_->cleanUp();
@@ -710,6 +752,7 @@ void GameWidget::onDealerTurnStarted() {
 
     // Flip hole card
     cardsView_->flipDealerHoleCard();
+    updateCountingLabel();
 }
 
 void GameWidget::onHandSplit(int handIndex) {
@@ -746,8 +789,8 @@ void GameWidget::updateCountingLabel() {
         QString runningCount = QString::number(game_->getRunningCount());
         QString trueCount = QString::number(std::round(game_->getTrueCount() * 100)/100); // Round to 2 decimal places
 
-        QString labelText = QString("Running Count: %1\nTrue Count: %2")
-                                .arg(runningCount, trueCount);
+        QString labelText = QString("%1\nRunning Count: %2\nTrue Count: %3")
+                                .arg(CountingSystem::get(game_->getCountingSystem()).name, runningCount, trueCount);
 
         countLabel_->setText(labelText);
         countLabel_->adjustSize();  // Force Qt to calculate the label size based on text
@@ -770,7 +813,7 @@ void GameWidget::updateBalance(int updateAmount, int updateDelay, int animationD
     }
 
     QVariantAnimation* labelUpdateAnimation = new QVariantAnimation(this);
-    labelUpdateAnimation->setDuration(animationDuration);
+    labelUpdateAnimation->setDuration(game_->getClock().scale(animationDuration));
     labelUpdateAnimation->setStartValue(0);
     labelUpdateAnimation->setEndValue(updateAmount);
 
@@ -791,5 +834,7 @@ void GameWidget::updateBalance(int updateAmount, int updateDelay, int animationD
         ui_->balanceLabel->setText(QString("$%1").arg(balance_));
     });
 
-    QTimer::singleShot(updateDelay, [labelUpdateAnimation] () { labelUpdateAnimation->start(QAbstractAnimation::DeleteWhenStopped); });
+    game_->getClock().schedule(updateDelay, labelUpdateAnimation, [labelUpdateAnimation] () {
+        labelUpdateAnimation->start(QAbstractAnimation::DeleteWhenStopped);
+    });
 }
@@ -9,8 +9,13 @@
 #include <QGraphicsPixmapItem>
 #include <QVariantAnimation>
 #include <QMessageBox>
+#include <QTimer>
 #include "blackjack_game.h"
 #include "card.h"
+#include "decision_capture.h"
+#include "decision_export.h"
+#include "hand_history.h"
+#include "session_log.h"
 #include "strategy_chart_dialog.h"
 #include "cards_view.h"
 
@@ -136,7 +141,8 @@ private:
     /// animationDuration milliseconds.
     /// @param updateAmount The amount to be added to the balance.
     /// @param updateDelay The time to wait before animating the balance change.
-    /// @param animationDuration The length of the balance update animation.
+    /// @param animationDuration The length of the balance update animation, scaled by
+    /// the game clock like the delay.
     void updateBalance(int updateAmount, int updateDelay, int animationDuration);
 
     /// @brief The size of the chip icons.
@@ -156,15 +162,16 @@ private:
     /// @brief The duration between flashes of the start round button, in milliseconds.
     static constexpr int START_BUTTON_FLASH_DURATION = 500;
 
+    /// @brief The time the last hand's result is shown before the table is cleared for
+    /// the next round, in milliseconds.
+    static constexpr int NEXT_ROUND_DELAY = 2000;
+
     /// @brief The UI form associated with this widget.
     Ui::GameWidget* ui_;
 
     /// @brief The game currently being played.
     BlackjackGame* game_;
 
-    /// @brief Timer for delaying animations and such.
-    QTimer timer_;
-
     /// @brief The player's balance (necessary to ensure the player doesn't
     /// bet more than they have).
     int balance_;
@@ -193,6 +200,14 @@ private:
     /// @brief Resets the game.
     void resetGame();
 
+    /// @brief Appends the events of the game's session log since the last save to its
+    /// file, so the session can be replayed later (e.g., to reproduce a reported bug).
+    /// Called after every round and when returning to the main menu.
+    void saveSessionLog();
+
+    /// @brief Writes out the session's decision exports and closes their files.
+    void finishDecisionExports();
+
     /// @brief The strategy chart overlay widget.
     StrategyChartDialog* strategyOverlay_;
 
@@ -220,6 +235,21 @@ private:
 
     /// @brief Whether the count label is currently being displayed.
     bool showingCountLabel_;
+
+    /// @brief Appends every completed round to the hand history.
+    HandHistoryWriter history_;
+
+    /// @brief Keeps the session log's file up to date.
+    SessionLogWriter sessionLogFile_;
+
+    /// @brief Streams the session's decisions to a columnar file for analysis.
+    ColumnarDecisionWriter decisionFile_;
+
+    /// @brief Streams the session's decisions to a CSV file for spreadsheets.
+    CsvDecisionWriter decisionCsv_;
+
+    /// @brief Captures the player's decisions from the game for the exports.
+    DecisionCapture* decisionCapture_;
 };
 
 #endif // GAME_WIDGET_H
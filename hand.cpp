@@ -0,0 +1,31 @@
+#include "hand.h"
+
+Hand::Hand() : hardTotal_(0), hasAce_(false), isPair_(false)
+{}
+
+Hand::Hand(const QVector<Card>& cards) : cards_(cards) {
+    recount();
+}
+
+Card Hand::takeLast() {
+    Card card = cards_.takeLast();
+    recount();
+    return card;
+}
+
+void Hand::clear() {
+    cards_.clear();
+    hardTotal_ = 0;
+    hasAce_ = false;
+    isPair_ = false;
+}
+
+void Hand::recount() {
+    hardTotal_ = 0;
+    hasAce_ = false;
+    for (const auto& card : cards_) {
+        hardTotal_ += card.rank == Card::Rank::Ace ? 1 : card.getBlackjackValue();
+        hasAce_ |= card.rank == Card::Rank::Ace;
+    }
+    isPair_ = cards_.size() == 2 && cards_[0].getBlackjackValue() == cards_[1].getBlackjackValue();
+}
@@ -0,0 +1,87 @@
+#ifndef HAND_H
+#define HAND_H
+
+#include <QVector>
+#include "card.h"
+
+/// @brief A blackjack hand. Along with its cards, the hand keeps its hard total, whether
+/// it holds an ace, and whether it is a pair up to date as each card is added, so every
+/// query about its value is O(1) instead of a scan over the cards.
+class Hand {
+public:
+    /// @brief Creates an empty hand.
+    Hand();
+
+    /// @brief Creates a hand holding the given cards.
+    /// @param cards The cards in the hand, in the order they were dealt.
+    explicit Hand(const QVector<Card>& cards);
+
+    /// @brief Adds a card to the hand, updating its totals.
+    /// @param card The card to add.
+    void addCard(Card card) {
+        cards_.append(card);
+        hardTotal_ += card.rank == Card::Rank::Ace ? 1 : card.getBlackjackValue();
+        hasAce_ |= card.rank == Card::Rank::Ace;
+        isPair_ = cards_.size() == 2 && cards_[0].getBlackjackValue() == card.getBlackjackValue();
+    }
+
+    /// @brief Removes and returns the last card in the hand, updating its totals.
+    /// @return The card removed.
+    Card takeLast();
+
+    /// @brief Removes every card from the hand.
+    void clear();
+
+    /// @brief Gets the cards in the hand, in the order they were dealt.
+    const QVector<Card>& cards() const { return cards_; }
+
+    /// @brief Gets the number of cards in the hand.
+    int size() const { return cards_.size(); }
+
+    /// @brief Gets one of the cards in the hand.
+    /// @param index The index of the card, in the order it was dealt.
+    Card operator[](int index) const { return cards_[index]; }
+
+    /// @brief Gets the total of the hand with every ace counted as 1.
+    int getHardTotal() const { return hardTotal_; }
+
+    /// @brief Gets the total value of the hand. One ace is counted as 11 if that does not
+    /// bust the hand; every other ace is counted as 1.
+    int getValue() const { return isSoft() ? hardTotal_ + 10 : hardTotal_; }
+
+    /// @brief Returns true if the hand contains at least one ace.
+    bool hasAce() const { return hasAce_; }
+
+    /// @brief Returns true if the hand is soft (contains an ace counted as 11).
+    bool isSoft() const { return hasAce_ && hardTotal_ <= 11; }
+
+    /// @brief Returns true if the hand is a bust.
+    bool isBust() const { return hardTotal_ > 21; }
+
+    /// @brief Returns true if the hand is worth 21.
+    bool is21() const { return getValue() == 21; }
+
+    /// @brief Returns true if the hand is a blackjack (21 in two cards).
+    bool isBlackjack() const { return cards_.size() == 2 && hasAce_ && hardTotal_ == 11; }
+
+    /// @brief Returns true if the hand is exactly two cards of the same value.
+    bool isPair() const { return isPair_; }
+
+private:
+    /// @brief The cards in the hand.
+    QVector<Card> cards_;
+
+    /// @brief The total of the hand with every ace counted as 1.
+    int hardTotal_;
+
+    /// @brief True if the hand contains at least one ace.
+    bool hasAce_;
+
+    /// @brief True if the hand is exactly two cards of the same value.
+    bool isPair_;
+
+    /// @brief Recomputes the totals from the cards in the hand.
+    void recount();
+};
+
+#endif // HAND_H
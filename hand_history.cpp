@@ -0,0 +1,145 @@
+#include "hand_history.h"
+#include <cstring>
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+HandHistoryRecord::HandHistoryRecord() {
+    std::memset(this, 0, sizeof(*this));
+}
+
+void HandHistoryRecord::addAction(BasicStrategyChecker::PlayerAction action) {
+    if (actionCount == MAX_ACTIONS) {
+        flags |= Truncated;
+        return;
+    }
+    actions[actionCount++] = static_cast<quint8>(action);
+}
+
+void HandHistoryRecord::setRound(const RoundEngine& engine, qint64 timestamp) {
+    this->timestamp = timestamp;
+    balance = engine.getBalance();
+
+    int cardCount = 0;
+    auto addCards = [this, &cardCount](const Hand& hand) {
+        int added = qMin(hand.size(), MAX_CARDS - cardCount);
+        for (int i = 0; i < added; ++i)
+            cards[cardCount++] = hand[i].pack();
+        if (added < hand.size())
+            flags |= Truncated;
+        return added;
+    };
+
+    dealerCardCount = static_cast<quint8>(addCards(engine.getDealerHand()));
+    handCount = static_cast<quint8>(qMin(engine.getHandCount(), MAX_HANDS));
+    if (handCount < engine.getHandCount())
+        flags |= Truncated;
+    for (int i = 0; i < handCount; ++i) {
+        RoundEngine::HandOutcome outcome = engine.getHandOutcome(i);
+        bets[i] = engine.getBetAmount(i);
+        payouts[i] = outcome.payout;
+        results[i] = static_cast<quint8>(outcome.result);
+        handCardCounts[i] = static_cast<quint8>(addCards(engine.getPlayerHand(i)));
+    }
+}
+
+HandHistoryHeader HandHistoryHeader::create() {
+    HandHistoryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = FILE_MAGIC;
+    header.version = FILE_VERSION;
+    header.recordSize = sizeof(HandHistoryRecord);
+    header.byteOrder = 0x01020304;
+    return header;
+}
+
+bool HandHistoryHeader::isValid() const {
+    return magic == FILE_MAGIC && version == FILE_VERSION && recordSize == sizeof(HandHistoryRecord)
+        && byteOrder == 0x01020304;
+}
+
+QString HandHistoryWriter::getDefaultPath() {
+    QDir directory(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+    return directory.filePath("history/hands.bjhh");
+}
+
+bool HandHistoryWriter::open(const QString& path) {
+    file_.close();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    // Never append to a file this build would write differently. A file too short to
+    // hold a header was torn by a crash while it was created, and holds no records
+    QFile existing(path);
+    qint64 tornBytes = 0;
+    if (existing.open(QIODevice::ReadOnly) && existing.size() >= static_cast<qint64>(sizeof(HandHistoryHeader))) {
+        HandHistoryHeader header;
+        if (existing.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header) || !header.isValid())
+            return false;
+        qint64 recordBytes = existing.size() - static_cast<qint64>(sizeof(header));
+        tornBytes = recordBytes % static_cast<qint64>(sizeof(HandHistoryRecord));
+    } else {
+        tornBytes = existing.size();
+    }
+    existing.close();
+
+    file_.setFileName(path);
+    if (!file_.open(QIODevice::WriteOnly | QIODevice::Append))
+        return false;
+
+    // Cut off a record (or header) torn by a crash, so the records that follow stay aligned
+    if (tornBytes != 0 && !file_.resize(file_.size() - tornBytes)) {
+        file_.close();
+        return false;
+    }
+
+    if (file_.size() == 0) {
+        HandHistoryHeader header = HandHistoryHeader::create();
+        if (file_.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header) || !file_.flush()) {
+            file_.close();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool HandHistoryWriter::isOpen() const {
+    return file_.isOpen();
+}
+
+bool HandHistoryWriter::append(const HandHistoryRecord& record) {
+    if (!file_.isOpen())
+        return false;
+    qint64 written = file_.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    return file_.flush() && written == sizeof(record);
+}
+
+HandHistoryReader::HandHistoryReader() : records_(nullptr), size_(0) {}
+
+bool HandHistoryReader::open(const QString& path) {
+    close();
+    file_.setFileName(path);
+    if (!file_.open(QIODevice::ReadOnly))
+        return false;
+
+    qint64 fileSize = file_.size();
+    if (fileSize < static_cast<qint64>(sizeof(HandHistoryHeader))) {
+        close();
+        return false;
+    }
+    const uchar* data = file_.map(0, fileSize);
+    if (!data || !reinterpret_cast<const HandHistoryHeader*>(data)->isValid()) {
+        close();
+        return false;
+    }
+
+    // A partly written record at the end (from a crash while appending) is left out
+    records_ = reinterpret_cast<const HandHistoryRecord*>(data + sizeof(HandHistoryHeader));
+    size_ = (fileSize - static_cast<qint64>(sizeof(HandHistoryHeader))) / static_cast<qint64>(sizeof(HandHistoryRecord));
+    return true;
+}
+
+void HandHistoryReader::close() {
+    file_.close();
+    records_ = nullptr;
+    size_ = 0;
+}
@@ -0,0 +1,218 @@
+#ifndef HAND_HISTORY_H
+#define HAND_HISTORY_H
+
+#include <type_traits>
+#include <QFile>
+#include <QString>
+#include <QtGlobal>
+#include "basic_strategy_checker.h"
+#include "card.h"
+#include "round_engine.h"
+
+/// @brief One completed round, as a fixed-size record of plain bytes. Records are written
+/// to a hand-history file exactly as they are laid out in memory, so a HandHistoryReader
+/// can map the file and read them in place.
+///
+/// Cards are stored packed (see Card::pack): the dealer's cards first, then each of the
+/// player's hands in order. Rounds with more hands, cards, or actions than fit are stored
+/// with as many as fit and flagged as Truncated.
+struct alignas(8) HandHistoryRecord {
+    /// @brief The most hands a record holds.
+    static constexpr int MAX_HANDS = 8;
+
+    /// @brief The most player actions a record holds.
+    static constexpr int MAX_ACTIONS = 32;
+
+    /// @brief The most cards (dealer and player together) a record holds.
+    static constexpr int MAX_CARDS = 128;
+
+    /// @brief Flags set in flags.
+    enum Flag : quint8 {
+        /// @brief Some hands, cards, or actions of the round did not fit in the record.
+        Truncated = 1
+    };
+
+    /// @brief When the round ended, in milliseconds since the Unix epoch.
+    qint64 timestamp;
+
+    /// @brief The player's balance after the round.
+    qint32 balance;
+
+    /// @brief The number of the player's hands.
+    quint8 handCount;
+
+    /// @brief The number of the dealer's cards.
+    quint8 dealerCardCount;
+
+    /// @brief The number of player actions.
+    quint8 actionCount;
+
+    /// @brief The record's Flags.
+    quint8 flags;
+
+    /// @brief The final bet on each hand, including doubles.
+    qint32 bets[MAX_HANDS];
+
+    /// @brief The amount paid to the player for each hand, including the bet.
+    qint32 payouts[MAX_HANDS];
+
+    /// @brief The RoundEngine::GameResult of each hand.
+    quint8 results[MAX_HANDS];
+
+    /// @brief The number of cards in each hand.
+    quint8 handCardCounts[MAX_HANDS];
+
+    /// @brief The BasicStrategyChecker::PlayerAction of each action, in the order played.
+    quint8 actions[MAX_ACTIONS];
+
+    /// @brief The packed cards of the dealer, then of each hand.
+    quint8 cards[MAX_CARDS];
+
+    /// @brief Creates an empty record.
+    HandHistoryRecord();
+
+    /// @brief Adds a player action, in the order played.
+    void addAction(BasicStrategyChecker::PlayerAction action);
+
+    /// @brief Fills in the cards, bets, and results of a settled round, keeping the
+    /// actions added so far.
+    /// @param engine The engine that played the round.
+    /// @param timestamp When the round ended, in milliseconds since the Unix epoch.
+    void setRound(const RoundEngine& engine, qint64 timestamp);
+
+    /// @brief Gets one of the dealer's cards.
+    Card getDealerCard(int index) const {
+        return Card::unpack(cards[index]);
+    }
+
+    /// @brief Gets one of the cards of a player's hand.
+    Card getPlayerCard(int handIndex, int index) const {
+        int offset = dealerCardCount;
+        for (int i = 0; i < handIndex; ++i)
+            offset += handCardCounts[i];
+        return Card::unpack(cards[offset + index]);
+    }
+
+    /// @brief Gets the result of a hand.
+    RoundEngine::GameResult getResult(int handIndex) const {
+        return static_cast<RoundEngine::GameResult>(results[handIndex]);
+    }
+
+    /// @brief Gets a player action.
+    BasicStrategyChecker::PlayerAction getAction(int index) const {
+        return static_cast<BasicStrategyChecker::PlayerAction>(actions[index]);
+    }
+
+    /// @brief Gets the player's net winnings for the round: the total paid less the total
+    /// bet.
+    qint64 getNetWinnings() const {
+        qint64 net = 0;
+        for (int i = 0; i < handCount; ++i)
+            net += payouts[i] - bets[i];
+        return net;
+    }
+};
+
+static_assert(sizeof(HandHistoryRecord) == 256, "Hand history records should be 256 bytes");
+static_assert(std::is_trivially_copyable<HandHistoryRecord>::value,
+              "Hand history records are written and mapped as raw bytes");
+
+/// @brief The header at the start of a hand-history file.
+struct HandHistoryHeader {
+    /// @brief The first four bytes of a hand-history file ("BJHH").
+    static constexpr quint32 FILE_MAGIC = 0x424A4848;
+
+    /// @brief The version of the file format.
+    static constexpr quint16 FILE_VERSION = 1;
+
+    /// @brief FILE_MAGIC.
+    quint32 magic;
+
+    /// @brief FILE_VERSION.
+    quint16 version;
+
+    /// @brief The size of each record, in bytes.
+    quint16 recordSize;
+
+    /// @brief The value 0x01020304 as written by the machine that created the file.
+    /// Records are stored in the creating machine's byte order, so a file is only read on
+    /// machines where this reads back the same.
+    quint32 byteOrder;
+
+    /// @brief Pads the header to 64 bytes, keeping the records aligned.
+    quint8 reserved[52];
+
+    /// @brief Creates the header for a new file.
+    static HandHistoryHeader create();
+
+    /// @brief Returns true if this is the header of a file this build can read.
+    bool isValid() const;
+};
+
+static_assert(sizeof(HandHistoryHeader) == 64, "The hand history header should be 64 bytes");
+
+/// @brief Appends records to a hand-history file. The file is only ever appended to; a
+/// record torn by a crash is at the end and is ignored by readers.
+class HandHistoryWriter {
+public:
+    /// @brief Gets the path of the hand history in the application's data directory.
+    static QString getDefaultPath();
+
+    /// @brief Opens a file for appending, creating it (and its directory) if needed.
+    /// @param path The path of the file.
+    /// @return True if the file is open. False if it could not be opened, or holds
+    /// something other than a hand history this build can read.
+    bool open(const QString& path);
+
+    /// @brief Returns true if a file is open.
+    bool isOpen() const;
+
+    /// @brief Appends a record and flushes it to the file.
+    /// @return True if the whole record was written.
+    bool append(const HandHistoryRecord& record);
+
+private:
+    /// @brief The open file.
+    QFile file_;
+};
+
+/// @brief Reads a hand-history file by mapping it into memory. The records are read in
+/// place, so iterating over them neither parses nor allocates.
+class HandHistoryReader {
+public:
+    /// @brief Creates a reader with no file open.
+    HandHistoryReader();
+
+    /// @brief Maps a file. Records appended after this are not seen until it is opened
+    /// again.
+    /// @param path The path of the file.
+    /// @return True if the file was mapped and holds a hand history this build can read.
+    bool open(const QString& path);
+
+    /// @brief Unmaps the file.
+    void close();
+
+    /// @brief Gets the number of complete records.
+    qint64 size() const { return size_; }
+
+    /// @brief Gets a record.
+    const HandHistoryRecord& operator[](qint64 index) const { return records_[index]; }
+
+    /// @brief Gets the first record, for iterating.
+    const HandHistoryRecord* begin() const { return records_; }
+
+    /// @brief Gets one past the last record, for iterating.
+    const HandHistoryRecord* end() const { return records_ + size_; }
+
+private:
+    /// @brief The mapped file.
+    QFile file_;
+
+    /// @brief The first record in the mapping.
+    const HandHistoryRecord* records_;
+
+    /// @brief The number of complete records.
+    qint64 size_;
+};
+
+#endif // HAND_HISTORY_H
@@ -0,0 +1,167 @@
+#include "house_edge_simulator.h"
+#include "round_engine.h"
+#include <cmath>
+#include <vector>
+
+void SimulationStats::merge(const SimulationStats& other) {
+    rounds += other.rounds;
+    hands += other.hands;
+    wins += other.wins;
+    losses += other.losses;
+    pushes += other.pushes;
+    blackjacks += other.blackjacks;
+    surrenders += other.surrenders;
+    totalWagered += other.totalWagered;
+    netWinnings += other.netWinnings;
+    netWinningsSquared += other.netWinningsSquared;
+    for (size_t i = 0; i < trueCountBuckets.size(); ++i) {
+        trueCountBuckets[i].rounds += other.trueCountBuckets[i].rounds;
+        trueCountBuckets[i].netWinnings += other.trueCountBuckets[i].netWinnings;
+        trueCountBuckets[i].netWinningsSquared += other.trueCountBuckets[i].netWinningsSquared;
+    }
+}
+
+double SimulationStats::houseEdge() const {
+    if (rounds == 0) return 0;
+    return -static_cast<double>(netWinnings) / (static_cast<double>(rounds) * HouseEdgeSimulator::BET_UNIT);
+}
+
+double SimulationStats::variance() const {
+    if (rounds < 2) return 0;
+    double n = static_cast<double>(rounds);
+    double mean = netWinnings / n;
+    double sampleVariance = (netWinningsSquared - n * mean * mean) / (n - 1);
+    return sampleVariance / (static_cast<double>(HouseEdgeSimulator::BET_UNIT) * HouseEdgeSimulator::BET_UNIT);
+}
+
+double SimulationStats::houseEdgeMargin() const {
+    if (rounds == 0) return 0;
+    return HouseEdgeSimulator::Z_95 * std::sqrt(variance() / rounds);
+}
+
+double SimulationStats::playerEdgeAt(int trueCount) const {
+    const CountBucket& bucket = getTrueCountBucket(trueCount);
+    if (bucket.rounds == 0) return 0;
+    return static_cast<double>(bucket.netWinnings) / (static_cast<double>(bucket.rounds) * HouseEdgeSimulator::BET_UNIT);
+}
+
+double SimulationStats::frequency(qint64 count) const {
+    if (hands == 0) return 0;
+    return static_cast<double>(count) / hands;
+}
+
+double SimulationStats::frequencyMargin(qint64 count) const {
+    if (hands == 0) return 0;
+    double p = frequency(count);
+    return HouseEdgeSimulator::Z_95 * std::sqrt(p * (1 - p) / hands);
+}
+
+HouseEdgeSimulator::Worker::Worker(const Ruleset& rules, std::unique_ptr<PlayerStrategy> strategy) :
+    engine(rules, SIMULATION_BALANCE), strategy(std::move(strategy))
+{}
+
+HouseEdgeSimulator::HouseEdgeSimulator(const Ruleset& rules, StrategyFactory strategyFactory) :
+    rules_(rules), strategyFactory_(std::move(strategyFactory)), roundsPlayed_(0) {
+    if (!strategyFactory_)
+        strategyFactory_ = createBasicStrategy;
+}
+
+std::unique_ptr<PlayerStrategy> HouseEdgeSimulator::createBasicStrategy(const Ruleset& rules) {
+    return std::make_unique<BasicStrategyPlayer>(rules);
+}
+
+qint64 HouseEdgeSimulator::getShoeCount(const Ruleset& rules, qint64 rounds) {
+    double roundsPerShoe = Shoe(rules.numDecks).getCutPosition() / AVERAGE_CARDS_PER_ROUND;
+    qint64 shoes = static_cast<qint64>(std::ceil(rounds / qMax(roundsPerShoe, 1.0)));
+    return qBound<qint64>(1, shoes, WorkStealingScheduler::MAX_TASKS);
+}
+
+SimulationStats HouseEdgeSimulator::run(qint64 rounds, int threads, quint64 seed) {
+    qint64 shoes = getShoeCount(rules_, rounds);
+    threads = static_cast<int>(qBound<qint64>(1, threads, shoes));
+
+    std::vector<Worker> workers;
+    workers.reserve(threads);
+    for (int i = 0; i < threads; ++i)
+        workers.emplace_back(rules_, strategyFactory_(rules_));
+
+    roundsPlayed_ = 0;
+    scheduler_.run(shoes, threads, [this, &workers, seed](int worker, qint64 shoe) {
+        qint64 played = runShoe(workers[worker], seed, shoe);
+        roundsPlayed_.fetch_add(played, std::memory_order_relaxed);
+    });
+
+    // Every total is a sum, so the order shoes finish in does not affect the result
+    SimulationStats total;
+    for (const Worker& worker : workers)
+        total.merge(worker.stats);
+    return total;
+}
+
+void HouseEdgeSimulator::cancel() {
+    scheduler_.cancel();
+}
+
+bool HouseEdgeSimulator::isCancelled() const {
+    return scheduler_.isCancelled();
+}
+
+double HouseEdgeSimulator::getProgress() const {
+    qint64 shoes = scheduler_.getTaskCount();
+    if (shoes == 0) return 0;
+    return static_cast<double>(scheduler_.getCompletedTasks()) / shoes;
+}
+
+qint64 HouseEdgeSimulator::getRoundsPlayed() const {
+    return roundsPlayed_.load(std::memory_order_relaxed);
+}
+
+qint64 HouseEdgeSimulator::runShoe(Worker& worker, quint64 seed, qint64 shoe) const {
+    RoundEngine& engine = worker.engine;
+    PlayerStrategy& strategy = *worker.strategy;
+    SimulationStats& stats = worker.stats;
+    engine.seedShoe(seed, static_cast<quint64>(shoe));
+    auto decide = [&strategy](const RoundEngine& engine) {
+        return strategy.chooseAction(engine);
+    };
+
+    qint64 rounds = 0;
+    do {
+        // Between rounds every card out of the shoe has been seen, including the last
+        // round's hole card
+        int trueCount = IndexPlayer::getTrueCount(engine.getShoe().getComposition());
+        SimulationStats::CountBucket& bucket = stats.getTrueCountBucket(trueCount);
+        engine.setBalance(SIMULATION_BALANCE);
+        qint64 net = engine.playRound(BET_UNIT, decide);
+
+        rounds++;
+        stats.rounds++;
+        stats.netWinnings += net;
+        stats.netWinningsSquared += net * net;
+        bucket.rounds++;
+        bucket.netWinnings += net;
+        bucket.netWinningsSquared += net * net;
+        for (int i = 0; i < engine.getHandCount(); ++i) {
+            stats.hands++;
+            stats.totalWagered += engine.getBetAmount(i);
+            switch (engine.getHandOutcome(i).result) {
+            case RoundEngine::GameResult::Win:
+                stats.wins++;
+                break;
+            case RoundEngine::GameResult::Lose:
+                stats.losses++;
+                break;
+            case RoundEngine::GameResult::Push:
+                stats.pushes++;
+                break;
+            case RoundEngine::GameResult::Blackjack:
+                stats.blackjacks++;
+                break;
+            case RoundEngine::GameResult::Surrender:
+                stats.surrenders++;
+                break;
+            }
+        }
+    } while (!engine.getNeedsShuffling() && !scheduler_.isCancelled());
+    return rounds;
+}
@@ -0,0 +1,217 @@
+#ifndef HOUSE_EDGE_SIMULATOR_H
+#define HOUSE_EDGE_SIMULATOR_H
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <QtGlobal>
+#include "player_strategy.h"
+#include "round_engine.h"
+#include "ruleset.h"
+#include "work_stealing_scheduler.h"
+
+/// @brief Totals collected while simulating rounds. Net winnings are measured in chips,
+/// where one initial bet is HouseEdgeSimulator::BET_UNIT chips. Every field is a plain sum,
+/// so the results of separate simulations can be combined with merge.
+struct SimulationStats {
+    /// @brief Totals for the rounds that began at one Hi-Lo true count.
+    struct CountBucket {
+        /// @brief The number of rounds played.
+        qint64 rounds = 0;
+
+        /// @brief The sum of the player's net winnings over every round.
+        qint64 netWinnings = 0;
+
+        /// @brief The sum of the squares of the player's net winnings for each round.
+        qint64 netWinningsSquared = 0;
+    };
+
+    /// @brief The largest true count with its own bucket. Rounds at counts further from 0
+    /// are added to the bucket at the end of the range.
+    static constexpr int MAX_BUCKET_COUNT = 10;
+
+    /// @brief The number of rounds played.
+    qint64 rounds = 0;
+
+    /// @brief The number of hands played, counting each hand created by a split.
+    qint64 hands = 0;
+
+    /// @brief The number of hands won (not counting blackjacks).
+    qint64 wins = 0;
+
+    /// @brief The number of hands lost.
+    qint64 losses = 0;
+
+    /// @brief The number of hands pushed.
+    qint64 pushes = 0;
+
+    /// @brief The number of hands won with a blackjack.
+    qint64 blackjacks = 0;
+
+    /// @brief The number of hands surrendered.
+    qint64 surrenders = 0;
+
+    /// @brief The total amount bet, including doubles and splits.
+    qint64 totalWagered = 0;
+
+    /// @brief The sum of the player's net winnings over every round.
+    qint64 netWinnings = 0;
+
+    /// @brief The sum of the squares of the player's net winnings for each round.
+    qint64 netWinningsSquared = 0;
+
+    /// @brief The totals for each true count at the start of a round (rounded down), from
+    /// -MAX_BUCKET_COUNT to MAX_BUCKET_COUNT.
+    std::array<CountBucket, 2 * MAX_BUCKET_COUNT + 1> trueCountBuckets {};
+
+    /// @brief Gets the bucket for rounds that began at a true count.
+    /// @param trueCount The true count, rounded down. Counts outside the range of the
+    /// buckets get the bucket at the end of the range.
+    CountBucket& getTrueCountBucket(int trueCount) {
+        return trueCountBuckets[qBound(-MAX_BUCKET_COUNT, trueCount, MAX_BUCKET_COUNT) + MAX_BUCKET_COUNT];
+    }
+
+    /// @brief Gets the bucket for rounds that began at a true count.
+    const CountBucket& getTrueCountBucket(int trueCount) const {
+        return trueCountBuckets[qBound(-MAX_BUCKET_COUNT, trueCount, MAX_BUCKET_COUNT) + MAX_BUCKET_COUNT];
+    }
+
+    /// @brief Adds another set of totals into this one.
+    /// @param other The totals to add.
+    void merge(const SimulationStats& other);
+
+    /// @brief Gets the house edge: the player's expected loss per round as a fraction of
+    /// the initial bet.
+    double houseEdge() const;
+
+    /// @brief Gets the variance of the player's net result per round, in initial bets
+    /// squared.
+    double variance() const;
+
+    /// @brief Gets the half-width of the 95% confidence interval around the house edge.
+    double houseEdgeMargin() const;
+
+    /// @brief Gets the player's expected result per round, as a fraction of the initial
+    /// bet, over the rounds that began at a true count (the negative of the house edge).
+    /// @param trueCount The true count, rounded down.
+    double playerEdgeAt(int trueCount) const;
+
+    /// @brief Gets the fraction of hands that ended with the given count.
+    /// @param count One of wins, losses, pushes, blackjacks, or surrenders.
+    double frequency(qint64 count) const;
+
+    /// @brief Gets the half-width of the 95% confidence interval around the fraction of
+    /// hands that ended with the given count.
+    /// @param count One of wins, losses, pushes, blackjacks, or surrenders.
+    double frequencyMargin(qint64 count) const;
+};
+
+/// @brief Estimates the house edge of a ruleset by playing rounds with a RoundEngine (the
+/// round logic BlackjackGame plays) as fast as possible.
+///
+/// Each task plays one shoe, shuffled from its own stream of the seed, from the first
+/// round until the cut card comes out. The number of rounds in a shoe varies with splits
+/// and doubles, so the shoes are spread over the threads by a WorkStealingScheduler. Every
+/// thread has its own engine, strategy, and totals, and nothing is shared while rounds are
+/// played; the totals are merged once every thread has finished. Because a shoe's rounds
+/// depend only on the seed and the shoe's index, the merged totals for a seed are the same
+/// whatever the number of threads.
+///
+/// Progress can be read, and the run cancelled, from another thread.
+class HouseEdgeSimulator {
+public:
+    /// @brief Creates a new strategy for one simulation thread.
+    using StrategyFactory = std::function<std::unique_ptr<PlayerStrategy>(const Ruleset&)>;
+
+    /// @brief The size of every initial bet, in chips. A multiple of 10 keeps 3:2 and 6:5
+    /// blackjack payouts exact.
+    static constexpr int BET_UNIT = 100;
+
+    /// @brief The balance each simulated round starts from, large enough that the player
+    /// can always afford to double and split. Simulators that play with a bankroll track it
+    /// separately.
+    static constexpr int SIMULATION_BALANCE = std::numeric_limits<int>::max() / 2;
+
+    /// @brief The z-score of every simulator's 95% confidence intervals.
+    static constexpr double Z_95 = 1.96;
+
+    /// @brief The average number of cards dealt in a round with one player, used to work
+    /// out how many shoes make up a given number of rounds.
+    static constexpr double AVERAGE_CARDS_PER_ROUND = 5.4;
+
+    /// @brief Creates a new HouseEdgeSimulator.
+    /// @param rules The rules to simulate.
+    /// @param strategyFactory Creates the strategy each thread plays with. If empty, the
+    /// threads play basic strategy.
+    explicit HouseEdgeSimulator(const Ruleset& rules, StrategyFactory strategyFactory = nullptr);
+
+    /// @brief Creates a basic strategy player: the StrategyFactory every simulator uses when
+    /// given none.
+    static std::unique_ptr<PlayerStrategy> createBasicStrategy(const Ruleset& rules);
+
+    /// @brief Gets the number of shoes to play for about the given number of rounds.
+    /// @param rules The rules to simulate.
+    /// @param rounds The number of rounds.
+    /// @return The number of shoes, at least 1.
+    static qint64 getShoeCount(const Ruleset& rules, qint64 rounds);
+
+    /// @brief Simulates whole shoes until about the given number of rounds have been
+    /// played (see getShoeCount); the exact number is in the result.
+    /// @param rounds The number of rounds to play.
+    /// @param threads The number of threads to play on (at least 1).
+    /// @param seed The seed for the shoes.
+    /// @return The merged totals of every round played, including those played before the
+    /// run was cancelled.
+    SimulationStats run(qint64 rounds, int threads, quint64 seed);
+
+    /// @brief Stops the current run after the rounds in progress. May be called from any
+    /// thread.
+    void cancel();
+
+    /// @brief Returns true if the current (or last) run was cancelled.
+    bool isCancelled() const;
+
+    /// @brief Gets the fraction of the current run's shoes that have been played, from 0
+    /// to 1. May be called from any thread.
+    double getProgress() const;
+
+    /// @brief Gets the number of rounds played so far in the current run, counting only
+    /// finished shoes. May be called from any thread.
+    qint64 getRoundsPlayed() const;
+
+private:
+    /// @brief The engine, strategy, and totals of one thread. Each has its own cache
+    /// lines, so threads never write to memory another thread is using.
+    struct alignas(64) Worker {
+        Worker(const Ruleset& rules, std::unique_ptr<PlayerStrategy> strategy);
+
+        RoundEngine engine;
+        std::unique_ptr<PlayerStrategy> strategy;
+        SimulationStats stats;
+    };
+
+    /// @brief Plays one shoe on the calling thread, from a fresh shuffle until the cut
+    /// card is drawn.
+    /// @param worker The calling thread's worker. The shoe's totals are added to its
+    /// stats.
+    /// @param seed The seed for the simulation.
+    /// @param shoe The index of the shoe, used as the stream of the seed.
+    /// @return The number of rounds played.
+    qint64 runShoe(Worker& worker, quint64 seed, qint64 shoe) const;
+
+    /// @brief The rules to simulate.
+    Ruleset rules_;
+
+    /// @brief Creates the strategy for each thread.
+    StrategyFactory strategyFactory_;
+
+    /// @brief Shares the shoes among the threads.
+    WorkStealingScheduler scheduler_;
+
+    /// @brief The number of rounds in the current run's finished shoes.
+    std::atomic<qint64> roundsPlayed_;
+};
+
+#endif // HOUSE_EDGE_SIMULATOR_H
@@ -2,12 +2,14 @@
 #include "ui_mainwindow.h"
 #include "game_widget.h"
 #include "blackjack_game.h"
+#include "game_clock.h"
 #include "ui_mainwindow.h"
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui_(new Ui::MainWindow)
-    , currentRules_() {
+    , currentRules_()
+    , timeScale_(GameClock::getDefault().getTimeScale()) {
     ui_->setupUi(this);
 
     // Create the stacked widget
@@ -54,6 +56,10 @@ void MainWindow::onLearnButtonClicked() {
 void MainWindow::onRulesetSaved() {
     // Retrieve the configuration from the widget and store it
     currentRules_ = rulesetWidget_->getRuleset();
+    timeScale_ = rulesetWidget_->getTimeScale();
+
+    // Speed up or slow down every game from here on, including one already running
+    GameClock::getDefault().setTimeScale(timeScale_);
 }
 
 void MainWindow::onReturnToMainMenuClicked() {
@@ -83,5 +89,6 @@ void MainWindow::onPracticeButtonClicked() {
 void MainWindow::onRulesetButtonClicked() {
     // Load the current stored rules into the widget before showing it
     rulesetWidget_->setRuleset(currentRules_);
+    rulesetWidget_->setTimeScale(timeScale_);
     stackedWidget_->setCurrentWidget(rulesetWidget_);
 }
@@ -62,5 +62,8 @@ private:
     /// @brief The current rules.
     Ruleset currentRules_;
 
+    /// @brief The animation time every game runs at: 1 is normal speed, 0 instant.
+    double timeScale_;
+
 };
 #endif // MAINWINDOW_H
@@ -0,0 +1,54 @@
+#include "player_strategy.h"
+#include <cmath>
+
+BasicStrategyPlayer::BasicStrategyPlayer(const Ruleset& rules) :
+    checker_(rules)
+{}
+
+BasicStrategyChecker::PlayerAction BasicStrategyPlayer::chooseAction(const RoundEngine& engine) {
+    return engine.getBestMove(checker_);
+}
+
+IndexPlayer::IndexPlayer(const Ruleset& rules) :
+    deviations_(DeviationTable::forRuleset(BasicStrategyChecker(rules), rules))
+{}
+
+BasicStrategyChecker::PlayerAction IndexPlayer::chooseAction(const RoundEngine& engine) {
+    return engine.getBestMove(deviations_, getTrueCount(engine));
+}
+
+int IndexPlayer::getTrueCount(const RoundEngine& engine) {
+    return getTrueCount(engine.getUnseenCards());
+}
+
+int IndexPlayer::getTrueCount(const Composition& unseen) {
+    // A full shoe counts to zero, so the count of the cards seen is the negative of the
+    // count of the cards not seen
+    int unseenCount = 0;
+    for (int i = 0; i < Composition::VALUE_COUNT; ++i) {
+        int value = Composition::valueOf(i);
+        int hiLo = value == 1 || value == 10 ? -1 : (value <= 6 ? 1 : 0);
+        unseenCount += hiLo * unseen.counts[i];
+    }
+    if (unseen.total == 0)
+        return 0;
+    return static_cast<int>(std::floor(-unseenCount / (unseen.total / 52.0)));
+}
+
+CompositionPlayer::CompositionPlayer(const Ruleset& rules) :
+    calculator_(rules)
+{}
+
+BasicStrategyChecker::PlayerAction CompositionPlayer::chooseAction(const RoundEngine& engine) {
+    using PlayerAction = BasicStrategyChecker::PlayerAction;
+    ExpectedValueCalculator::ActionValues values = engine.getActionValues(calculator_);
+
+    // Hitting and standing are always playable; the other actions depend on the hand
+    PlayerAction best = values.hit > values.stand ? PlayerAction::Hit : PlayerAction::Stand;
+    for (PlayerAction action : { PlayerAction::Double, PlayerAction::Split, PlayerAction::Surrender }) {
+        double value = values.valueOf(action);
+        if (!std::isnan(value) && value > values.valueOf(best) && engine.canMakeAction(action))
+            best = action;
+    }
+    return best;
+}
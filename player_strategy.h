@@ -0,0 +1,85 @@
+#ifndef PLAYER_STRATEGY_H
+#define PLAYER_STRATEGY_H
+
+#include "basic_strategy_checker.h"
+#include "composition.h"
+#include "deviation_table.h"
+#include "expected_value_calculator.h"
+#include "round_engine.h"
+#include "ruleset.h"
+
+/// @brief Decides the player's actions when a round is played without a human, such as in
+/// the simulator. Implementations may keep state between decisions, so each thread should
+/// use its own instance.
+class PlayerStrategy {
+public:
+    virtual ~PlayerStrategy() = default;
+
+    /// @brief Chooses the player's next action for the engine's current hand.
+    /// @param engine The engine whose round is being played.
+    /// @return An action the player is able to make with the current hand.
+    virtual BasicStrategyChecker::PlayerAction chooseAction(const RoundEngine& engine) = 0;
+};
+
+/// @brief Plays every hand by the basic strategy tables in BasicStrategyChecker.
+class BasicStrategyPlayer : public PlayerStrategy {
+public:
+    /// @brief Creates a new BasicStrategyPlayer.
+    /// @param rules The rules the player is playing under.
+    explicit BasicStrategyPlayer(const Ruleset& rules);
+
+    /// @brief Chooses the best playable basic strategy move for the current hand.
+    BasicStrategyChecker::PlayerAction chooseAction(const RoundEngine& engine) override;
+
+private:
+    /// @brief The basic strategy tables for the player's rules.
+    BasicStrategyChecker checker_;
+};
+
+/// @brief Plays basic strategy with the Illustrious 18 and Fab 4 index plays, keeping a
+/// perfect Hi-Lo count of every card it has seen.
+class IndexPlayer : public PlayerStrategy {
+public:
+    /// @brief Creates a new IndexPlayer.
+    /// @param rules The rules the player is playing under.
+    explicit IndexPlayer(const Ruleset& rules);
+
+    /// @brief Chooses the best playable move for the current hand at the current true
+    /// count.
+    BasicStrategyChecker::PlayerAction chooseAction(const RoundEngine& engine) override;
+
+    /// @brief Gets the Hi-Lo true count of the cards the player has seen, rounded down.
+    /// The count is worked out from the cards not yet seen, so it needs no updating as
+    /// cards are dealt and resets itself when the shoe is shuffled.
+    /// @param engine The engine whose round is being played.
+    static int getTrueCount(const RoundEngine& engine);
+
+    /// @brief Gets the Hi-Lo true count, rounded down, of a shoe from the cards not yet
+    /// seen.
+    /// @param unseen The cards not yet seen.
+    static int getTrueCount(const Composition& unseen);
+
+private:
+    /// @brief The index plays and the basic strategy they deviate from.
+    DeviationTable deviations_;
+};
+
+/// @brief Plays every decision by the exact expected value of each action for the cards
+/// the player has not seen (see ExpectedValueCalculator), so its play depends on the
+/// cards in the hand and the composition of the shoe, not just the hand's total.
+/// Much slower than the table-driven players, since each decision is solved.
+class CompositionPlayer : public PlayerStrategy {
+public:
+    /// @brief Creates a new CompositionPlayer.
+    /// @param rules The rules the player is playing under.
+    explicit CompositionPlayer(const Ruleset& rules);
+
+    /// @brief Chooses the playable action with the highest expected value.
+    BasicStrategyChecker::PlayerAction chooseAction(const RoundEngine& engine) override;
+
+private:
+    /// @brief Solves each decision, reusing dealer solves between decisions.
+    ExpectedValueCalculator calculator_;
+};
+
+#endif // PLAYER_STRATEGY_H
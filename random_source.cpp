@@ -0,0 +1,46 @@
+#include "random_source.h"
+#include <QRandomGenerator>
+
+namespace {
+
+/// @brief Advances a SplitMix64 state and returns its next output.
+quint64 splitMix64(quint64& state) {
+    quint64 z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+}
+
+quint32 RandomSource::bounded(quint32 range) {
+    quint64 m = (next() >> 32) * range;
+    quint32 low = static_cast<quint32>(m);
+    if (low < range) {
+        // Reject the few samples that would make some results more likely than others
+        const quint32 threshold = static_cast<quint32>(-range) % range;
+        while (low < threshold) {
+            m = (next() >> 32) * range;
+            low = static_cast<quint32>(m);
+        }
+    }
+    return static_cast<quint32>(m >> 32);
+}
+
+Xoshiro256::Xoshiro256() {
+    seed(QRandomGenerator::global()->generate64(), 0);
+}
+
+Xoshiro256::Xoshiro256(quint64 seed, quint64 stream) {
+    this->seed(seed, stream);
+}
+
+void Xoshiro256::seed(quint64 seed, quint64 stream) {
+    // Hash the seed and stream together into a starting point for SplitMix64, so that
+    // nearby seeds and streams start far apart
+    quint64 mixer = seed;
+    quint64 start = splitMix64(mixer) ^ stream;
+    start = splitMix64(start);
+    for (quint64& word : state_)
+        word = splitMix64(start);
+}
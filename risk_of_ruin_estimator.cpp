@@ -0,0 +1,180 @@
+#include "risk_of_ruin_estimator.h"
+#include <cmath>
+
+namespace {
+
+/// @brief The number of shoe streams each replication may use.
+constexpr quint64 STREAMS_PER_REPLICATION = quint64(1) << 40;
+
+}
+
+double RuinEstimate::getPlainRoundsNeeded(qint64 horizonRounds) const {
+    if (standardError <= 0 || probability <= 0)
+        return 0;
+    double sessions = probability * (1 - probability) / (standardError * standardError);
+    return sessions * (1 - probability) * horizonRounds;
+}
+
+RiskOfRuinEstimator::RiskOfRuinEstimator(const Ruleset& rules, const BetRamp& ramp,
+                                         HouseEdgeSimulator::StrategyFactory strategyFactory) :
+    rules_(rules), ramp_(ramp), strategyFactory_(std::move(strategyFactory)), roundsPlayed_(0),
+    startBankroll_(0), horizonRounds_(0), trialsPerLevel_(0) {
+    if (!strategyFactory_)
+        strategyFactory_ = HouseEdgeSimulator::createBasicStrategy;
+}
+
+RuinEstimate RiskOfRuinEstimator::estimate(int bankrollUnits, qint64 horizonRounds, int levelCount,
+                                           int trialsPerLevel, int replications, int threads, quint64 seed) {
+    replications = qMax(1, replications);
+    threads = qBound(1, threads, replications);
+    trialsPerLevel_ = qMax(1, trialsPerLevel);
+    horizonRounds_ = qMax<qint64>(1, horizonRounds);
+
+    // Levels are evenly spaced between the starting bankroll and the largest bet, below
+    // which ruin is possible; the last level is ruin itself
+    startBankroll_ = static_cast<qint64>(bankrollUnits) * HouseEdgeSimulator::BET_UNIT;
+    qint64 floor = static_cast<qint64>(ramp_.maxUnits) * HouseEdgeSimulator::BET_UNIT;
+    levelCount = startBankroll_ > floor ? qMax(1, levelCount) : 1;
+    levels_.assign(levelCount, 0);
+    for (int level = 0; level < levelCount - 1; ++level)
+        levels_[level] = floor + (startBankroll_ - floor) * (levelCount - 1 - level) / levelCount;
+
+    std::vector<std::unique_ptr<PlayerStrategy>> strategies;
+    for (int i = 0; i < threads; ++i)
+        strategies.push_back(strategyFactory_(rules_));
+    std::vector<Replication> results(replications);
+    roundsPlayed_ = 0;
+    scheduler_.run(replications, threads, [&](int worker, qint64 replication) {
+        Replication& result = results[replication];
+        result.levelProbabilities.assign(levelCount, 0);
+        runReplication(*strategies[worker], result, seed, replication);
+        roundsPlayed_.fetch_add(result.rounds, std::memory_order_relaxed);
+    });
+
+    RuinEstimate estimate;
+    estimate.levelProbabilities.fill(0, levelCount);
+    double sum = 0;
+    double sumSquared = 0;
+    for (const Replication& result : results) {
+        estimate.roundsPlayed += result.rounds;
+        if (!result.finished)
+            continue;
+        estimate.replications++;
+        sum += result.probability;
+        sumSquared += result.probability * result.probability;
+        for (int level = 0; level < levelCount; ++level)
+            estimate.levelProbabilities[level] += result.levelProbabilities[level];
+    }
+    if (estimate.replications == 0)
+        return estimate;
+
+    double n = estimate.replications;
+    estimate.probability = sum / n;
+    if (estimate.replications > 1) {
+        double variance = qMax(0.0, (sumSquared - n * estimate.probability * estimate.probability) / (n - 1));
+        estimate.standardError = std::sqrt(variance / n);
+    }
+    for (double& probability : estimate.levelProbabilities)
+        probability /= n;
+    return estimate;
+}
+
+void RiskOfRuinEstimator::cancel() {
+    scheduler_.cancel();
+}
+
+bool RiskOfRuinEstimator::isCancelled() const {
+    return scheduler_.isCancelled();
+}
+
+double RiskOfRuinEstimator::getProgress() const {
+    qint64 replications = scheduler_.getTaskCount();
+    if (replications == 0) return 0;
+    return static_cast<double>(scheduler_.getCompletedTasks()) / replications;
+}
+
+qint64 RiskOfRuinEstimator::getRoundsPlayed() const {
+    return roundsPlayed_.load(std::memory_order_relaxed);
+}
+
+void RiskOfRuinEstimator::runReplication(PlayerStrategy& strategy, Replication& result, quint64 seed,
+                                         qint64 replication) const {
+    quint64 nextStream = static_cast<quint64>(replication) * STREAMS_PER_REPLICATION;
+    std::vector<Trajectory> starts { { RoundEngine(rules_, HouseEdgeSimulator::SIMULATION_BALANCE),
+                                       CountTracker(rules_.numDecks), startBankroll_, 0, true } };
+    std::vector<Trajectory> hits;
+    result.probability = 1;
+    for (int level = 0; level < static_cast<int>(levels_.size()); ++level) {
+        hits.clear();
+        for (int trial = 0; trial < trialsPerLevel_; ++trial) {
+            // Spread the trials evenly over the states that reached the last level, and
+            // give each its own future. The first stage starts every trial from a fresh
+            // shoe.
+            Trajectory trajectory = starts[trial % starts.size()];
+            if (level == 0) {
+                trajectory.engine.seedShoe(seed, nextStream++);
+                trajectory.counts.reset();
+            } else {
+                trajectory.engine.reseedUndealt(seed, nextStream++);
+            }
+            if (advance(trajectory, strategy, level, seed, nextStream, result.rounds))
+                hits.push_back(std::move(trajectory));
+            if (scheduler_.isCancelled())
+                return;
+        }
+
+        double fraction = static_cast<double>(hits.size()) / trialsPerLevel_;
+        result.levelProbabilities[level] = fraction;
+        result.probability *= fraction;
+        if (hits.empty())
+            break;
+        std::swap(starts, hits);
+    }
+    result.finished = true;
+}
+
+bool RiskOfRuinEstimator::advance(Trajectory& trajectory, PlayerStrategy& strategy, int level, quint64 seed,
+                                  quint64& nextStream, qint64& rounds) const {
+    RoundEngine& engine = trajectory.engine;
+    bool ruinLevel = level == static_cast<int>(levels_.size()) - 1;
+    auto decide = [&strategy](const RoundEngine& engine) {
+        return strategy.chooseAction(engine);
+    };
+
+    // A round can fall through several levels at once; a trajectory that starts this stage
+    // below its level has already reached it
+    if (!ruinLevel && trajectory.bankroll < levels_[level])
+        return true;
+
+    while (trajectory.round < horizonRounds_) {
+        if (engine.getNeedsShuffling()) {
+            engine.seedShoe(seed, nextStream++);
+            trajectory.counts.reset();
+        }
+
+        // Between rounds every card out of the shoe has been seen, including the last
+        // round's hole card
+        int trueCount = static_cast<int>(std::floor(trajectory.counts.getTrueCount(ramp_.countingSystem)));
+        if (ramp_.wongOut) {
+            if (trajectory.seated && trueCount < ramp_.wongOutBelow)
+                trajectory.seated = false;
+            else if (!trajectory.seated && trueCount >= ramp_.wongInAt)
+                trajectory.seated = true;
+        }
+        int units = trajectory.seated ? ramp_.getUnits(trueCount) : 0;
+        if (ruinLevel && units > 0 && trajectory.bankroll < static_cast<qint64>(units) * HouseEdgeSimulator::BET_UNIT)
+            return true;
+
+        engine.setBalance(HouseEdgeSimulator::SIMULATION_BALANCE);
+        qint64 net = engine.playRound(HouseEdgeSimulator::BET_UNIT, decide);
+        trajectory.counts.observeRound(engine);
+        trajectory.bankroll += net * units;
+        trajectory.round++;
+        rounds++;
+        if (!ruinLevel && trajectory.bankroll < levels_[level])
+            return true;
+        if (scheduler_.isCancelled())
+            return false;
+    }
+    return false;
+}
@@ -0,0 +1,165 @@
+#ifndef RISK_OF_RUIN_ESTIMATOR_H
+#define RISK_OF_RUIN_ESTIMATOR_H
+
+#include <atomic>
+#include <vector>
+#include <QVector>
+#include <QtGlobal>
+#include "bankroll_simulator.h"
+#include "house_edge_simulator.h"
+#include "round_engine.h"
+#include "ruleset.h"
+#include "work_stealing_scheduler.h"
+
+/// @brief An estimate of the probability of ruin, from RiskOfRuinEstimator.
+struct RuinEstimate {
+    /// @brief The estimated probability that the bankroll cannot cover a bet within the
+    /// horizon.
+    double probability = 0;
+
+    /// @brief The standard error of the estimate, from the spread of the replications.
+    double standardError = 0;
+
+    /// @brief The number of independent replications averaged.
+    int replications = 0;
+
+    /// @brief The number of rounds dealt over every replication.
+    qint64 roundsPlayed = 0;
+
+    /// @brief The fraction of trajectories started from each level that reached the next,
+    /// averaged over the replications. The estimate is their product.
+    QVector<double> levelProbabilities;
+
+    /// @brief Gets the half-width of the 95% confidence interval around the estimate.
+    double margin() const { return HouseEdgeSimulator::Z_95 * standardError; }
+
+    /// @brief Gets a lower bound on the number of rounds plain Monte Carlo simulation
+    /// would need to reach the same standard error: the number of whole sessions it would
+    /// need, counting only the rounds of the sessions that are not ruined.
+    double getPlainRoundsNeeded(qint64 horizonRounds) const;
+};
+
+/// @brief Estimates the risk of ruin of a BetRamp and bankroll by multilevel splitting.
+///
+/// Ruin is rare for a realistic bankroll, so most plain simulated sessions say nothing
+/// about it. Splitting instead places levels between the starting bankroll and ruin, and
+/// estimates the chance of falling from each level to the next: a fixed number of
+/// trajectories is started from the states in which the previous level was reached,
+/// played until the bankroll drops below the next level (or the horizon is reached), and
+/// the states that reach it seed the next stage. The product of the stage fractions is an
+/// unbiased estimate of the probability of ruin, and every stage's fraction is large
+/// enough to measure with few trajectories.
+///
+/// A state is copied between rounds, so everything it has seen is fixed, and the copy is
+/// branched by reordering the undealt cards of its shoe from a new stream. Rounds are
+/// played by the RoundEngine as in BankrollSimulator: one unit per round, scaled by the
+/// ramp's bet, with ruin when the bankroll cannot cover the next bet.
+///
+/// Independent replications of the whole procedure run as tasks on a
+/// WorkStealingScheduler, and the spread of their estimates gives the confidence interval.
+/// A replication's result depends only on the seed and its index.
+class RiskOfRuinEstimator {
+public:
+    /// @brief Creates a new RiskOfRuinEstimator.
+    /// @param rules The rules to simulate.
+    /// @param ramp The betting strategy.
+    /// @param strategyFactory Creates the playing strategy of each thread. If empty, the
+    /// threads play basic strategy.
+    RiskOfRuinEstimator(const Ruleset& rules, const BetRamp& ramp,
+                        HouseEdgeSimulator::StrategyFactory strategyFactory = nullptr);
+
+    /// @brief Estimates the probability of ruin.
+    /// @param bankrollUnits The starting bankroll, in units.
+    /// @param horizonRounds The number of rounds dealt before a bankroll that has not been
+    /// ruined is counted as surviving.
+    /// @param levelCount The number of levels, counting ruin itself. More levels make each
+    /// stage's fraction larger; about one level per halving of the probability works well.
+    /// @param trialsPerLevel The number of trajectories started at each level.
+    /// @param replications The number of independent replications.
+    /// @param threads The number of threads to run on (at least 1).
+    /// @param seed The seed for the shoes.
+    /// @return The estimate, from the replications finished if the run was cancelled.
+    RuinEstimate estimate(int bankrollUnits, qint64 horizonRounds, int levelCount, int trialsPerLevel,
+                          int replications, int threads, quint64 seed);
+
+    /// @brief Stops the current run after the replications in progress. May be called
+    /// from any thread.
+    void cancel();
+
+    /// @brief Returns true if the current (or last) run was cancelled.
+    bool isCancelled() const;
+
+    /// @brief Gets the fraction of the current run's replications that have finished, from
+    /// 0 to 1. May be called from any thread.
+    double getProgress() const;
+
+    /// @brief Gets the number of rounds dealt so far in the current run, counting only
+    /// finished replications. May be called from any thread.
+    qint64 getRoundsPlayed() const;
+
+private:
+    /// @brief A point in a session, between rounds.
+    struct Trajectory {
+        RoundEngine engine;
+        CountTracker counts;
+        qint64 bankroll;
+        qint64 round;
+        bool seated;
+    };
+
+    /// @brief The result of one replication.
+    struct Replication {
+        double probability = 0;
+        qint64 rounds = 0;
+        std::vector<double> levelProbabilities;
+        bool finished = false;
+    };
+
+    /// @brief Runs one replication on the calling thread.
+    /// @param strategy The calling thread's playing strategy.
+    /// @param result Receives the replication's estimate; levelProbabilities must be
+    /// sized to the number of levels.
+    /// @param seed The seed for the run.
+    /// @param replication The index of the replication, which picks its streams.
+    void runReplication(PlayerStrategy& strategy, Replication& result, quint64 seed, qint64 replication) const;
+
+    /// @brief Plays a trajectory until it reaches a level, reaches the horizon, or the run
+    /// is cancelled.
+    /// @param level The index of the level to reach; the last level is ruin.
+    /// @param nextStream The next unused stream of the replication, advanced for each
+    /// shoe shuffled.
+    /// @param rounds Incremented for each round dealt.
+    /// @return True if the level was reached.
+    bool advance(Trajectory& trajectory, PlayerStrategy& strategy, int level, quint64 seed, quint64& nextStream,
+                 qint64& rounds) const;
+
+    /// @brief The rules to simulate.
+    Ruleset rules_;
+
+    /// @brief The betting strategy.
+    BetRamp ramp_;
+
+    /// @brief Creates the playing strategy for each thread.
+    HouseEdgeSimulator::StrategyFactory strategyFactory_;
+
+    /// @brief Shares the replications among the threads.
+    WorkStealingScheduler scheduler_;
+
+    /// @brief The number of rounds in the current run's finished replications.
+    std::atomic<qint64> roundsPlayed_;
+
+    /// @brief The bankroll, in chips, below which each level is reached, for the current
+    /// run. The last level is ruin, which is checked against the next bet instead.
+    std::vector<qint64> levels_;
+
+    /// @brief The starting bankroll of the current run, in chips.
+    qint64 startBankroll_;
+
+    /// @brief The number of rounds dealt in a session of the current run.
+    qint64 horizonRounds_;
+
+    /// @brief The number of trajectories started at each level in the current run.
+    int trialsPerLevel_;
+};
+
+#endif // RISK_OF_RUIN_ESTIMATOR_H
@@ -0,0 +1,51 @@
+QT       = core concurrent testlib
+
+CONFIG += c++20 console testcase
+CONFIG -= app_bundle
+
+TARGET = round-flow-test
+
+SOURCES += \
+    basic_strategy_checker.cpp \
+    blackjack_game.cpp \
+    counting_system.cpp \
+    dealer_outcome_cache.cpp \
+    dealer_outcomes.cpp \
+    deviation_table.cpp \
+    expected_value_calculator.cpp \
+    game_clock.cpp \
+    hand.cpp \
+    hand_history.cpp \
+    random_source.cpp \
+    round_engine.cpp \
+    round_flow_test.cpp \
+    session_log.cpp \
+    session_replayer.cpp \
+    shoe.cpp \
+    strategy_solver.cpp \
+    strategy_tables.cpp \
+    work_stealing_scheduler.cpp
+
+HEADERS += \
+    basic_strategy_checker.h \
+    blackjack_game.h \
+    card.h \
+    composition.h \
+    counting_system.h \
+    dealer_outcome_cache.h \
+    dealer_outcomes.h \
+    deviation_table.h \
+    expected_value_calculator.h \
+    game_clock.h \
+    hand.h \
+    hand_history.h \
+    random_source.h \
+    round_engine.h \
+    round_task.h \
+    ruleset.h \
+    session_log.h \
+    session_replayer.h \
+    shoe.h \
+    strategy_solver.h \
+    strategy_tables.h \
+    work_stealing_scheduler.h
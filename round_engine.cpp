@@ -0,0 +1,496 @@
+#include "round_engine.h"
+
+RoundEngine::RoundEngine(const Ruleset& rules, int balance) :
+    rules_(rules), shoe_(rules.numDecks), observer_(nullptr), balance_(balance),
+    phase_(Phase::Idle), needsShuffling_(true), currentHandIndex_(0), settledHands_(0)
+{}
+
+void RoundEngine::setRuleset(const Ruleset& rules) {
+    if (rules.numDecks != rules_.numDecks) {
+        shoe_.setDecks(rules.numDecks);
+        needsShuffling_ = false;
+    }
+    rules_ = rules;
+}
+
+const Ruleset& RoundEngine::getRuleset() const {
+    return rules_;
+}
+
+void RoundEngine::setObserver(Observer* observer) {
+    observer_ = observer;
+}
+
+const Shoe& RoundEngine::getShoe() const {
+    return shoe_;
+}
+
+void RoundEngine::seedShoe(quint64 seed, quint64 stream) {
+    shoe_.seed(seed, stream);
+    needsShuffling_ = false;
+}
+
+void RoundEngine::reseedUndealt(quint64 seed, quint64 stream) {
+    shoe_.reseedUndealt(seed, stream);
+}
+
+int RoundEngine::getBalance() const {
+    return balance_;
+}
+
+void RoundEngine::setBalance(int balance) {
+    balance_ = balance;
+}
+
+void RoundEngine::setNeedsShuffling(bool needsShuffling) {
+    needsShuffling_ = needsShuffling;
+}
+
+bool RoundEngine::getNeedsShuffling() const {
+    return needsShuffling_;
+}
+
+RoundEngine::Phase RoundEngine::getPhase() const {
+    return phase_;
+}
+
+bool RoundEngine::isRoundInProgress() const {
+    return phase_ != Phase::Idle;
+}
+
+// Dealing
+
+void RoundEngine::startRound(int betAmount) {
+    balance_ -= betAmount;
+    if (observer_) observer_->onBetPlaced(betAmount);
+
+    // Check shuffling status.
+    if (needsShuffling_) {
+        shoe_.shuffle();
+        needsShuffling_ = false;
+    }
+
+    // Reset necessary elements.
+    playerHands_.resize(1);
+    playerHands_[0].clear();
+    betAmounts_.resize(1);
+    betAmounts_[0] = betAmount;
+    doubled_.resize(1);
+    doubled_[0] = false;
+    outcomes_.clear();
+    dealerHand_.clear();
+    currentHandIndex_ = 0;
+    settledHands_ = 0;
+    phase_ = Phase::Dealing;
+}
+
+Card RoundEngine::drawCard() {
+    if (shoe_.isAtCutCard()) {
+        needsShuffling_ = true;
+        if (observer_) observer_->onCutCardDrawn();
+    }
+    return shoe_.draw();
+}
+
+Card RoundEngine::dealPlayerCard(int handIndex, bool isLastCard) {
+    Card c = drawCard();
+    playerHands_[handIndex].addCard(c);
+    if (observer_) observer_->onPlayerCardDealt(c, handIndex, isLastCard);
+    return c;
+}
+
+Card RoundEngine::dealDealerCard() {
+    Card c = drawCard();
+    dealerHand_.addCard(c);
+    if (observer_) observer_->onDealerCardDealt(c);
+    return c;
+}
+
+void RoundEngine::dealInitialCards() {
+    for (int i = 0; i < 2; ++i) {
+        dealPlayerCard(0, false);
+        dealDealerCard();
+    }
+}
+
+bool RoundEngine::checkForBlackjacks() {
+    bool playerHasBJ = playerHands_[0].isBlackjack();
+
+    // Without a peek, the dealer's blackjack is only revealed on the dealer's turn
+    bool dealerHasBJ = rules_.dealerPeeks && dealerHand_.isBlackjack();
+
+    if (playerHasBJ || dealerHasBJ) {
+        phase_ = Phase::Settling;
+        return true;
+    }
+    phase_ = Phase::PlayerTurn;
+    return false;
+}
+
+// Player Actions
+
+bool RoundEngine::hit() {
+    if (phase_ != Phase::PlayerTurn) return false;
+    dealPlayerCard(currentHandIndex_, false);
+    return true;
+}
+
+bool RoundEngine::stand() {
+    if (phase_ != Phase::PlayerTurn) return false;
+
+    int nextHand = findNextPlayableHand(currentHandIndex_ + 1);
+    if (nextHand != -1) {
+        currentHandIndex_ = nextHand;
+        return true;
+    }
+    phase_ = Phase::DealerTurn;
+    return false;
+}
+
+bool RoundEngine::doubleDown() {
+    if (phase_ != Phase::PlayerTurn || !canDouble()) return false;
+
+    dealPlayerCard(currentHandIndex_, true);
+    balance_ -= betAmounts_[currentHandIndex_];
+    if (observer_) observer_->onBetPlaced(betAmounts_[currentHandIndex_]);
+    betAmounts_[currentHandIndex_] *= 2;
+    doubled_[currentHandIndex_] = true;
+    return true;
+}
+
+bool RoundEngine::split() {
+    if (phase_ != Phase::PlayerTurn || !canSplit()) return false;
+
+    // Update player hands
+    Card splitCard = playerHands_[currentHandIndex_].takeLast();
+    Hand newHand;
+    newHand.addCard(splitCard);
+    playerHands_.insert(currentHandIndex_ + 1, newHand);
+    doubled_.insert(currentHandIndex_ + 1, false);
+
+    // Update bet amounts
+    betAmounts_.insert(currentHandIndex_ + 1, betAmounts_[currentHandIndex_]);
+    balance_ -= betAmounts_[currentHandIndex_];
+    if (observer_) observer_->onBetPlaced(betAmounts_[currentHandIndex_]);
+
+    // New cards should be last cards of their hands if splitting aces and
+    // rules declare no hitting after splitting aces
+    bool isLastCard = splitCard.rank == Card::Rank::Ace && !rules_.hitSplitAces;
+
+    if (observer_) observer_->onHandSplit(currentHandIndex_);
+
+    // Deal new cards
+    dealPlayerCard(currentHandIndex_, isLastCard);
+    dealPlayerCard(currentHandIndex_ + 1, isLastCard);
+    return true;
+}
+
+RoundEngine::HandOutcome RoundEngine::surrender() {
+    // If surrender is not allowed at this moment, ignore the action.
+    if (!canSurrender()) return { GameResult::Lose, 0 };
+
+    // Late surrender: player gets half the bet back, loses the hand.
+    HandOutcome outcome { GameResult::Surrender,
+                          calculatePayout(GameResult::Surrender, betAmounts_[currentHandIndex_]) };
+    balance_ += outcome.payout;
+    outcomes_.resize(playerHands_.size());
+    outcomes_[currentHandIndex_] = outcome;
+    phase_ = Phase::Idle;
+    return outcome;
+}
+
+void RoundEngine::applyAction(BasicStrategyChecker::PlayerAction action) {
+    bool acted = false;
+    switch (action) {
+    case BasicStrategyChecker::PlayerAction::Hit:
+        acted = hit();
+        break;
+    case BasicStrategyChecker::PlayerAction::Double:
+        acted = doubleDown();
+        break;
+    case BasicStrategyChecker::PlayerAction::Split:
+    case BasicStrategyChecker::PlayerAction::SplitIfDas:
+        acted = split();
+        break;
+    case BasicStrategyChecker::PlayerAction::Surrender:
+        surrender();
+        acted = phase_ == Phase::Idle;
+        break;
+    default:
+        break;
+    }
+
+    if (!acted || (phase_ == Phase::PlayerTurn && isHandComplete(currentHandIndex_)))
+        stand();
+}
+
+// Dealer methods
+
+bool RoundEngine::dealerShouldHit() const {
+    int value = dealerHand_.getValue();
+    if (value < 17) {
+        return true;
+    }
+    if (value == 17 && rules_.dealerHitsSoft17 && dealerHand_.isSoft()) {
+        return true;
+    }
+    return false;
+}
+
+Card RoundEngine::dealerHit() {
+    return dealDealerCard();
+}
+
+void RoundEngine::playDealerHand() {
+    // Only continue drawing if at least one player hand is alive
+    if (!allHandsBusted()) {
+        while (dealerShouldHit())
+            dealerHit();
+    }
+    phase_ = Phase::Settling;
+}
+
+// Results
+
+RoundEngine::GameResult RoundEngine::determineWinner(int handIndex) const {
+    const Hand& playerHand = playerHands_[handIndex];
+    int playerValue = playerHand.getValue();
+    int dealerValue = dealerHand_.getValue();
+
+    // Check Busts
+    if (playerValue > 21) {
+        return GameResult::Lose;
+    }
+    if (dealerValue > 21) {
+        // Free bet style: a dealer 22 pushes instead of busting
+        if (dealerValue == 22 && rules_.pushOnDealer22)
+            return GameResult::Push;
+        return GameResult::Win;
+    }
+
+    // Check Blackjacks - only count as blackjack if not from a split
+    bool pBJ = playerHands_.size() == 1 && playerHand.isBlackjack();
+    bool dBJ = dealerHand_.isBlackjack();
+
+    if (pBJ && !dBJ) {
+        return GameResult::Blackjack;
+    }
+    if (dBJ && !pBJ) {
+        return GameResult::Lose;
+    }
+    if (pBJ && dBJ) {
+        return GameResult::Push;
+    }
+
+    // Compare Values
+    if (playerValue > dealerValue) {
+        return GameResult::Win;
+    }
+    if (playerValue < dealerValue) {
+        return GameResult::Lose;
+    }
+
+    // Otherwise a push
+    return GameResult::Push;
+}
+
+int RoundEngine::calculatePayout(GameResult result, int betAmount) const {
+    switch (result) {
+    case GameResult::Win:
+        // Give player back the money they bet and the money they made
+        return betAmount * 2;
+    case GameResult::Push:
+        // Give player back the money they bet
+        return betAmount;
+    case GameResult::Blackjack:
+        // Give back bet amount, then give payout based on ruleset
+        return static_cast<int>(betAmount * (1 + rules_.blackjackPayout));
+    case GameResult::Surrender:
+        // Give back half the bet
+        return betAmount / 2;
+    default:
+        // If player loses, pay nothing
+        return 0;
+    }
+}
+
+RoundEngine::HandOutcome RoundEngine::settleHand(int handIndex) {
+    GameResult result = determineWinner(handIndex);
+    HandOutcome outcome { result, calculatePayout(result, betAmounts_[handIndex]) };
+    balance_ += outcome.payout;
+
+    outcomes_.resize(playerHands_.size());
+    outcomes_[handIndex] = outcome;
+    if (++settledHands_ >= playerHands_.size())
+        phase_ = Phase::Idle;
+    return outcome;
+}
+
+// Queries
+
+bool RoundEngine::canDouble() const {
+    return playerHands_[currentHandIndex_].size() == 2 && (rules_.doubleAfterSplit || playerHands_.size() == 1)
+        && balance_ >= betAmounts_[currentHandIndex_];
+}
+
+bool RoundEngine::canSurrender() const {
+    // Surrender must be allowed in rules
+    if (!rules_.surrenderAllowed) return false;
+
+    if (phase_ != Phase::PlayerTurn) return false;
+
+    // Only allow on the initial hand, before any split
+    if (playerHands_.size() != 1) return false;
+    if (currentHandIndex_ != 0) return false;
+
+    // Only when this hand has exactly two cards (no hits yet)
+    if (playerHands_[0].size() != 2) return false;
+
+    return true;
+}
+
+bool RoundEngine::canSplit() const {
+    const Hand& hand = playerHands_[currentHandIndex_];
+    if (!hand.isPair()) {
+        return false;
+    }
+    if (playerHands_.size() > 1) {
+        if (!rules_.resplit)
+            return false;
+        if (hand[0].rank == Card::Rank::Ace && !rules_.resplitAces)
+            return false;
+    }
+    if (balance_ < betAmounts_[currentHandIndex_]) {
+        return false;
+    }
+    return true;
+}
+
+bool RoundEngine::canMakeAction(BasicStrategyChecker::PlayerAction action) const {
+    switch (action) {
+    case BasicStrategyChecker::PlayerAction::Split:
+        return canSplit();
+    case BasicStrategyChecker::PlayerAction::SplitIfDas:
+        return rules_.doubleAfterSplit && canSplit();
+    case BasicStrategyChecker::PlayerAction::Double:
+        return canDouble();
+    case BasicStrategyChecker::PlayerAction::Surrender:
+        return canSurrender();
+    default:
+        return true;
+    }
+}
+
+BasicStrategyChecker::PlayerAction RoundEngine::getBestMove(const BasicStrategyChecker& checker) const {
+    const Hand& hand = playerHands_[currentHandIndex_];
+    Card upcard = dealerHand_[0];
+
+    return getFirstPlayableMove(checker.getMoves(hand, upcard));
+}
+
+BasicStrategyChecker::PlayerAction RoundEngine::getBestMove(const DeviationTable& deviations, int trueCount) const {
+    const Hand& hand = playerHands_[currentHandIndex_];
+    Card upcard = dealerHand_[0];
+    return getFirstPlayableMove(deviations.getMoves(hand, upcard, trueCount));
+}
+
+BasicStrategyChecker::PlayerAction RoundEngine::getFirstPlayableMove(BasicStrategyChecker::MoveChain moves) const {
+    if (canMakeAction(moves.best))
+        return moves.best;
+    if (canMakeAction(moves.second))
+        return moves.second;
+    return moves.third;
+}
+
+Composition RoundEngine::getUnseenCards() const {
+    Composition unseen = shoe_.getComposition();
+    if (dealerHand_.size() >= 2)
+        unseen.add(dealerHand_[1]);
+    return unseen;
+}
+
+ExpectedValueCalculator::ActionValues RoundEngine::getActionValues(const ExpectedValueCalculator& calculator) const {
+    return calculator.evaluate(playerHands_[currentHandIndex_], dealerHand_[0], getUnseenCards(),
+                               playerHands_.size() > 1);
+}
+
+bool RoundEngine::isHandComplete(int handIndex) const {
+    const Hand& hand = playerHands_[handIndex];
+    if (hand.getValue() >= 21 || doubled_[handIndex])
+        return true;
+
+    // Split aces receive only one card each unless the rules allow hitting them
+    return playerHands_.size() > 1 && hand[0].rank == Card::Rank::Ace && !rules_.hitSplitAces;
+}
+
+bool RoundEngine::allHandsBusted() const {
+    for (const auto& hand : playerHands_) {
+        if (!hand.isBust()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int RoundEngine::findNextPlayableHand(int startIndex) const {
+    for (int i = startIndex; i < playerHands_.size(); ++i) {
+        if (!isHandComplete(i)) {
+            return i;
+        }
+    }
+    return -1;  // No playable hands found
+}
+
+int RoundEngine::getCurrentHandIndex() const {
+    return currentHandIndex_;
+}
+
+int RoundEngine::getHandCount() const {
+    return playerHands_.size();
+}
+
+const Hand& RoundEngine::getPlayerHand(int handIndex) const {
+    return playerHands_[handIndex];
+}
+
+const Hand& RoundEngine::getCurrentHand() const {
+    return playerHands_[currentHandIndex_];
+}
+
+int RoundEngine::getBetAmount(int handIndex) const {
+    return betAmounts_[handIndex];
+}
+
+const Hand& RoundEngine::getDealerHand() const {
+    return dealerHand_;
+}
+
+Card RoundEngine::getDealerUpcard() const {
+    return dealerHand_[0];
+}
+
+RoundEngine::HandOutcome RoundEngine::getHandOutcome(int handIndex) const {
+    return outcomes_[handIndex];
+}
+
+// Static hand evaluation
+
+int RoundEngine::getHandValue(const QVector<Card>& hand) {
+    return Hand(hand).getValue();
+}
+
+bool RoundEngine::isBust(const QVector<Card>& hand) {
+    return Hand(hand).isBust();
+}
+
+bool RoundEngine::isBlackJack(const QVector<Card>& hand) {
+    return Hand(hand).isBlackjack();
+}
+
+bool RoundEngine::is21(const QVector<Card>& hand) {
+    return Hand(hand).is21();
+}
+
+bool RoundEngine::isSoftHand(const QVector<Card>& hand) {
+    return Hand(hand).isSoft();
+}
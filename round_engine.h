@@ -0,0 +1,414 @@
+#ifndef ROUND_ENGINE_H
+#define ROUND_ENGINE_H
+
+#include <QVector>
+#include "card.h"
+#include "composition.h"
+#include "deviation_table.h"
+#include "expected_value_calculator.h"
+#include "hand.h"
+#include "ruleset.h"
+#include "shoe.h"
+#include "basic_strategy_checker.h"
+
+/// @brief The rules of a single blackjack round (dealing, player decisions, dealer play,
+/// and settlement), with no timers, signals, or QObject dependencies. Every step runs
+/// synchronously, so a full round can be played with a single call to playRound. The
+/// animated BlackjackGame drives the same steps one at a time, waiting between them.
+class RoundEngine {
+public:
+    /// @brief defines an enum for the different possible results of a hand.
+    enum class GameResult {
+        Win,
+        Lose,
+        Push,
+        Blackjack,
+        Surrender
+    };
+
+    /// @brief The stages of a round, in the order they occur.
+    enum class Phase {
+        Idle,
+        Dealing,
+        PlayerTurn,
+        DealerTurn,
+        Settling
+    };
+
+    /// @brief The result of a single settled hand.
+    struct HandOutcome {
+        /// @brief The result of the hand.
+        GameResult result;
+
+        /// @brief The amount paid to the player for the hand (including their original bet).
+        int payout;
+    };
+
+    /// @brief Receives notifications as the engine deals cards and takes bets, allowing a
+    /// front end to animate the round. Every method is called synchronously, at the moment
+    /// the corresponding event happens in the engine.
+    class Observer {
+    public:
+        virtual ~Observer() = default;
+
+        /// @brief Called when a card is dealt to one of the player's hands.
+        /// @param card The card that is dealt.
+        /// @param handIndex The hand that is dealt to.
+        /// @param isLastCard Indicates whether this is the last card to be dealt for the
+        /// hand (if the player doubled or split aces).
+        virtual void onPlayerCardDealt(Card card, int handIndex, bool isLastCard) = 0;
+
+        /// @brief Called when a card is dealt to the dealer.
+        /// @param card The card that is dealt.
+        virtual void onDealerCardDealt(Card card) = 0;
+
+        /// @brief Called when the cut card is drawn from the shoe.
+        virtual void onCutCardDrawn() = 0;
+
+        /// @brief Called when the player places a bet (either at the start of the round,
+        /// by doubling, or by splitting).
+        /// @param amount The amount of the bet.
+        virtual void onBetPlaced(int amount) = 0;
+
+        /// @brief Called when a hand splits, before the new cards are dealt.
+        /// @param handIndex The index of the hand that is split.
+        virtual void onHandSplit(int handIndex) = 0;
+    };
+
+    /// @brief Creates a new RoundEngine with the given rules.
+    /// @param rules The rules to play by.
+    /// @param balance The player's starting balance.
+    explicit RoundEngine(const Ruleset& rules = Ruleset(), int balance = 1000);
+
+    /// @brief Changes the rules of the game. If the number of decks changes, the shoe is
+    /// rebuilt.
+    /// @param rules The new ruleset.
+    void setRuleset(const Ruleset& rules);
+
+    /// @brief Gets the current ruleset.
+    const Ruleset& getRuleset() const;
+
+    /// @brief Sets the observer that is notified of cards dealt and bets placed, or
+    /// nullptr to run without one.
+    void setObserver(Observer* observer);
+
+    /// @brief Gets the shoe the engine draws from.
+    const Shoe& getShoe() const;
+
+    /// @brief Reseeds the shoe and starts a fresh shoe shuffled from the seed, so that
+    /// every following round is reproducible from the seed.
+    /// @param seed The new seed.
+    /// @param stream The stream of the seed to use (see Shoe::seed).
+    void seedShoe(quint64 seed, quint64 stream = 0);
+
+    /// @brief Reorders the cards left in the shoe from a new seed, leaving the cards
+    /// already dealt in place (see Shoe::reseedUndealt). Used between rounds to branch a
+    /// copy of an engine into an independent future.
+    /// @param seed The new seed.
+    /// @param stream The stream of the seed to use.
+    void reseedUndealt(quint64 seed, quint64 stream);
+
+    /// @brief Gets the player's current balance.
+    int getBalance() const;
+
+    /// @brief Sets the player's balance.
+    void setBalance(int balance);
+
+    /// @brief Requests (or cancels a request) that the shoe be shuffled before the next
+    /// round begins.
+    void setNeedsShuffling(bool needsShuffling);
+
+    /// @brief Returns true if the shoe will be shuffled before the next round begins,
+    /// such as once the cut card has been drawn.
+    bool getNeedsShuffling() const;
+
+    /// @brief Gets the current phase of the round.
+    Phase getPhase() const;
+
+    /// @brief Returns true if a round has started and has not been fully settled.
+    bool isRoundInProgress() const;
+
+    // Round steps. These are called in order by playRound, or one at a time by an
+    // animated front end.
+
+    /// @brief Takes the player's bet, shuffles the shoe if needed, and clears the hands
+    /// from the previous round. No cards are dealt.
+    /// @param betAmount The amount the player bets on the round.
+    void startRound(int betAmount);
+
+    /// @brief Draws a card from the shoe. If the cut card is reached, the shoe is marked
+    /// for shuffling before the next round and the card after the cut card is returned.
+    /// @return The card drawn.
+    Card drawCard();
+
+    /// @brief Deals a card to one of the player's hands.
+    /// @param handIndex The index of the hand to deal to.
+    /// @param isLastCard Indicates whether this is the last card to be dealt to the hand.
+    /// @return The card dealt.
+    Card dealPlayerCard(int handIndex, bool isLastCard = false);
+
+    /// @brief Deals a card to the dealer.
+    /// @return The card dealt.
+    Card dealDealerCard();
+
+    /// @brief Deals the two initial cards to the player and the dealer, alternating
+    /// player, dealer, player, dealer.
+    void dealInitialCards();
+
+    /// @brief Checks the initial hands for blackjacks once all four initial cards are
+    /// dealt. If the player has a blackjack, or the dealer peeks and has a blackjack, the
+    /// round skips straight to settlement. Otherwise, the player's turn begins.
+    /// @return true if the round ends without the player acting, false otherwise.
+    bool checkForBlackjacks();
+
+    /// @brief Player draws another card to the current hand.
+    /// @return true if a card was dealt, false if the player cannot hit right now.
+    bool hit();
+
+    /// @brief Player stands on the current hand, moving on to the next playable hand. If
+    /// there are none, the dealer's turn begins.
+    /// @return true if there is another hand for the player to play, false if it is now
+    /// the dealer's turn.
+    bool stand();
+
+    /// @brief Player doubles the current hand's bet and draws exactly one more card.
+    /// @return true if the player doubled, false if doubling is not allowed.
+    bool doubleDown();
+
+    /// @brief Player splits the current hand into two hands, placing a matching bet on
+    /// the new hand and dealing a card to each.
+    /// @return true if the player split, false if splitting is not allowed.
+    bool split();
+
+    /// @brief Player surrenders the round, getting back half of their bet. Does nothing
+    /// if the player cannot surrender.
+    /// @return The outcome of the surrendered hand.
+    HandOutcome surrender();
+
+    /// @brief Determines if the dealer should draw another card.
+    /// @return true if dealer should hit.
+    bool dealerShouldHit() const;
+
+    /// @brief Deals another card to the dealer.
+    /// @return The card dealt.
+    Card dealerHit();
+
+    /// @brief Plays out the dealer's hand, unless every player hand has busted.
+    void playDealerHand();
+
+    /// @brief Settles one of the player's hands against the dealer, paying the player.
+    /// Once the last hand is settled, the round is over.
+    /// @param handIndex The index of the hand to settle.
+    /// @return The outcome of the hand.
+    HandOutcome settleHand(int handIndex);
+
+    /// @brief Plays a complete round in one call: deals, asks decide for each player
+    /// decision, plays the dealer's hand, and settles every hand.
+    /// @param betAmount The amount the player bets on the round.
+    /// @param decide Called with this engine whenever the player must act. Must return
+    /// an action the player is able to make (see canMakeAction).
+    /// @return The player's net winnings for the round (negative if they lost money).
+    template <typename Decide>
+    int playRound(int betAmount, Decide&& decide);
+
+    // Queries.
+
+    /// @brief Determines if the player can double based on their current active
+    /// hand and the ruleset.
+    /// @return true if player can double, false otherwise.
+    bool canDouble() const;
+
+    /// @brief determines if the player can surrender.
+    /// @return true if player can surrender.
+    bool canSurrender() const;
+
+    /// @brief determines if the player can split.
+    /// @return true if player can split.
+    bool canSplit() const;
+
+    /// @brief Returns true if the player can play the given action with the current
+    /// hand and ruleset. Otherwise, returns false. In the case where action is
+    /// BasicStrategyChecker::PlayerAction::SplitIfDas, but double after split (DAS)
+    /// is not allowed, returns false.
+    /// @param action The action to check for playability.
+    /// @returns A bool indicating whether the player is able to play (and should play)
+    /// the given action.
+    bool canMakeAction(BasicStrategyChecker::PlayerAction action) const;
+
+    /// @brief Finds the best playable move for the current hand according to the given
+    /// strategy checker, falling back to the second- and third-best moves when the best
+    /// move is not allowed.
+    /// @param checker The basic strategy checker to consult.
+    /// @return One of Hit, Double, Stand, Split, or Surrender.
+    BasicStrategyChecker::PlayerAction getBestMove(const BasicStrategyChecker& checker) const;
+
+    /// @brief Finds the best playable move for the current hand at the given true count,
+    /// applying any index play the table has for the hand.
+    /// @param deviations The index plays and the basic strategy they deviate from.
+    /// @param trueCount The true count, rounded down to an integer.
+    /// @return One of Hit, Double, Stand, Split, or Surrender.
+    BasicStrategyChecker::PlayerAction getBestMove(const DeviationTable& deviations, int trueCount) const;
+
+    /// @brief Gets the cards the player has not seen: the cards left in the shoe, plus
+    /// the dealer's hole card once it has been dealt.
+    Composition getUnseenCards() const;
+
+    /// @brief Computes the exact expected value of each action for the current hand,
+    /// given the cards the player has not seen.
+    /// @param calculator The calculator to use. Must use the same rules as this engine.
+    /// @return The expected value of each action, in units of the hand's bet.
+    ExpectedValueCalculator::ActionValues getActionValues(const ExpectedValueCalculator& calculator) const;
+
+    /// @brief Returns true if the player can take no further action on the given hand;
+    /// i.e., it has busted, reached 21, been doubled, or is a split ace that cannot be hit.
+    /// @param handIndex The index of the hand to check.
+    bool isHandComplete(int handIndex) const;
+
+    /// @brief Checks if all player hands are busted.
+    /// @return true if all hands are busted, false otherwise.
+    bool allHandsBusted() const;
+
+    /// @brief Gets the index of the hand the player is currently playing.
+    int getCurrentHandIndex() const;
+
+    /// @brief Gets the number of hands the player has this round.
+    int getHandCount() const;
+
+    /// @brief Gets one of the player's hands.
+    /// @param handIndex The index of the hand.
+    const Hand& getPlayerHand(int handIndex) const;
+
+    /// @brief Gets the current active player hand.
+    const Hand& getCurrentHand() const;
+
+    /// @brief Gets the bet placed on one of the player's hands.
+    /// @param handIndex The index of the hand.
+    int getBetAmount(int handIndex) const;
+
+    /// @brief Gets the dealer's hand.
+    const Hand& getDealerHand() const;
+
+    /// @brief Gets the dealer's upcard (first card).
+    Card getDealerUpcard() const;
+
+    /// @brief Gets the outcome of a hand that has already been settled this round.
+    /// @param handIndex The index of the hand.
+    HandOutcome getHandOutcome(int handIndex) const;
+
+    // Static hand evaluation, for lists of cards that are not held in a Hand.
+
+    /// @brief gets the total value of the hand.
+    /// Handles logic of ace being 1 or 11.
+    /// @param hand vector holding the cards.
+    /// @return reports aces as 11 unless that results in a bust.
+    static int getHandValue(const QVector<Card>& hand);
+
+    /// @brief determines if the current hand is a bust.
+    /// @param hand vector holding the cards.
+    /// @return true if the hand is a bust
+    static bool isBust(const QVector<Card>& hand);
+
+    /// @brief determines if the current hand is a blackjack.
+    /// @param hand vector holding the cards.
+    /// @return true if is blackjack.
+    static bool isBlackJack(const QVector<Card>& hand);
+
+    /// @brief determines if the current hand is 21.
+    /// @param hand vector holding the cards.
+    /// @return true if is 21.
+    static bool is21(const QVector<Card>& hand);
+
+    /// @brief determines if the current hand is soft (contains an ace counted as 11).
+    /// @param hand vector holding the cards.
+    /// @return true if is soft hand.
+    static bool isSoftHand(const QVector<Card>& hand);
+
+private:
+    /// @brief Gets the first move in a chain that the player can make.
+    BasicStrategyChecker::PlayerAction getFirstPlayableMove(BasicStrategyChecker::MoveChain moves) const;
+
+    /// @brief determines the winner of one of the player's hands against the dealer.
+    /// @param handIndex The index of the player's hand.
+    /// @return game result.
+    GameResult determineWinner(int handIndex) const;
+
+    /// @brief Calculates the payout for a hand with the given result.
+    /// @param result The result of the hand.
+    /// @param betAmount The bet placed on the hand.
+    /// @return The amount paid to the player (including their original bet).
+    int calculatePayout(GameResult result, int betAmount) const;
+
+    /// @brief Looks for the next playable hand.
+    /// @param startIndex The index from which to start looking.
+    /// @return The index of the next playable hand, -1 if none found.
+    int findNextPlayableHand(int startIndex) const;
+
+    /// @brief Applies one player decision, standing automatically if the decision
+    /// completes the current hand. Actions the player cannot make are treated as a stand.
+    /// @param action The action to apply.
+    void applyAction(BasicStrategyChecker::PlayerAction action);
+
+    /// @brief Holds the ruleset.
+    Ruleset rules_;
+
+    /// @brief The shoe of the blackjack game.
+    Shoe shoe_;
+
+    /// @brief Notified of cards dealt and bets placed. May be nullptr.
+    Observer* observer_;
+
+    /// @brief The amount of money the player has.
+    int balance_;
+
+    /// @brief The current phase of the round.
+    Phase phase_;
+
+    /// @brief Holds the player's current hands.
+    QVector<Hand> playerHands_;
+
+    /// @brief Holds the bet amounts for each of the player's hands.
+    QVector<int> betAmounts_;
+
+    /// @brief Holds whether each of the player's hands has been doubled.
+    QVector<bool> doubled_;
+
+    /// @brief Holds the outcome of each of the player's hands once settled.
+    QVector<HandOutcome> outcomes_;
+
+    /// @brief Holds the dealer's current hand.
+    Hand dealerHand_;
+
+    /// @brief True if the shoe needs shuffling. False otherwise.
+    bool needsShuffling_;
+
+    /// @brief Tracks which hand is currently active to account for split hands.
+    int currentHandIndex_;
+
+    /// @brief The number of hands settled so far this round.
+    int settledHands_;
+};
+
+template <typename Decide>
+int RoundEngine::playRound(int betAmount, Decide&& decide) {
+    int startingBalance = balance_;
+    startRound(betAmount);
+    dealInitialCards();
+
+    if (checkForBlackjacks()) {
+        settleHand(0);
+        return balance_ - startingBalance;
+    }
+
+    while (phase_ == Phase::PlayerTurn)
+        applyAction(decide(static_cast<const RoundEngine&>(*this)));
+
+    // A surrender settles the round during the player's turn
+    if (phase_ == Phase::DealerTurn) {
+        playDealerHand();
+        for (int i = 0; i < playerHands_.size(); ++i)
+            settleHand(i);
+    }
+    return balance_ - startingBalance;
+}
+
+#endif // ROUND_ENGINE_H
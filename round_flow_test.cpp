@@ -0,0 +1,212 @@
+#include <QRandomGenerator>
+#include <QVector>
+#include <QtTest>
+#include "blackjack_game.h"
+#include "game_clock.h"
+#include "session_log.h"
+#include "session_replayer.h"
+
+/// @brief Plays BlackjackGame's round coroutine on a VirtualClock and checks the order of
+/// its signals, its session log, and that destroying a game mid-round leaves nothing
+/// behind on the clock.
+class RoundFlowTest : public QObject {
+    Q_OBJECT
+
+private:
+    /// @brief One roundEnded signal.
+    struct Ended {
+        BlackjackGame::GameResult result;
+        int payout;
+        int handIndex;
+        int totalHands;
+    };
+
+    /// @brief What a session emitted.
+    struct Session {
+        QVector<Ended> ended;
+        int bets = 0;
+        int turns = 0;
+        int rounds = 0;
+        qint64 endTime = 0;
+        SessionLog log;
+    };
+
+    /// @brief The seed of every session's shoe.
+    static constexpr quint64 SHOE_SEED = 0x5eed;
+
+    /// @brief The most actions a round may ask for before it is taken to be stuck.
+    static constexpr int MAX_ACTIONS = 1000;
+
+    /// @brief Plays a session, choosing each action at random from a seeded generator
+    /// whenever the game waits for one.
+    /// @param rounds The number of rounds to play.
+    /// @param actionSeed The seed of the actions.
+    static Session playSession(int rounds, quint32 actionSeed);
+
+private slots:
+    /// @brief Every round runs to its end on the clock, with its hands settled in order, and
+    /// the session log replays to the same outcomes.
+    void playsSeededSession();
+
+    /// @brief The same seeds give the same session, step for step.
+    void repeatsSession();
+
+    /// @brief Destroying a game while its round waits on the clock drops the delay.
+    void destroysGameMidDelay();
+
+    /// @brief Destroying a game while its round waits for the player drops the round.
+    void destroysGameMidInput();
+};
+
+RoundFlowTest::Session RoundFlowTest::playSession(int rounds, quint32 actionSeed) {
+    VirtualClock clock;
+    BlackjackGame game(nullptr, &clock);
+    game.seedShoe(SHOE_SEED);
+    QRandomGenerator actions(actionSeed);
+
+    Session session;
+    connect(&game, &BlackjackGame::betPlaced, &game, [&session](int) { session.bets++; });
+    connect(&game, &BlackjackGame::playerTurn, &game, [&session](int, bool, bool, bool) { session.turns++; });
+    connect(&game, &BlackjackGame::roundEnded, &game,
+            [&session](BlackjackGame::GameResult result, int payout, int handIndex, int totalHands) {
+        session.ended.append({ result, payout, handIndex, totalHands });
+    });
+
+    for (int round = 0; round < rounds; ++round) {
+        int endedBefore = session.ended.size();
+        auto isOver = [&session, endedBefore]() {
+            return session.ended.size() > endedBefore
+                && session.ended.last().handIndex == session.ended.last().totalHands - 1;
+        };
+
+        // The game waits for an action whenever the clock has nothing left to run
+        game.beginRound(10);
+        clock.runUntilIdle();
+        for (int action = 0; !isOver(); ++action) {
+            if (action == MAX_ACTIONS)
+                return session;
+            switch (actions.bounded(6)) {
+            case 0:
+            case 1:
+                game.playerHit();
+                break;
+            case 2:
+                game.playerStand();
+                break;
+            case 3:
+                game.playerDouble();
+                break;
+            case 4:
+                game.playerSplit();
+                break;
+            default:
+                game.playerSurrender();
+                break;
+            }
+            clock.runUntilIdle();
+        }
+        if (clock.getPendingCount() != 0)
+            return session;
+        session.rounds++;
+    }
+    session.endTime = clock.now();
+    session.log = game.getSessionLog();
+    return session;
+}
+
+void RoundFlowTest::playsSeededSession() {
+    const int rounds = 500;
+    Session session = playSession(rounds, 1);
+    QCOMPARE(session.rounds, rounds);
+    QVERIFY(session.bets >= rounds); // Doubles and splits place bets of their own
+    QVERIFY(session.turns > 0);
+
+    // Each round settles its hands in order, once each
+    int nextHand = 0;
+    for (const Ended& ended : session.ended) {
+        QCOMPARE(ended.handIndex, nextHand);
+        nextHand = ended.handIndex == ended.totalHands - 1 ? 0 : nextHand + 1;
+    }
+    QCOMPARE(nextHand, 0);
+
+    // The log records one outcome per roundEnded, with the same result and payout
+    QCOMPARE(session.log.getSeed(), SHOE_SEED);
+    QVector<SessionLog::Event> outcomes;
+    for (const SessionLog::Event& event : session.log.getEvents()) {
+        if (event.type == SessionLog::EventType::Outcome)
+            outcomes.append(event);
+    }
+    QCOMPARE(outcomes.size(), session.ended.size());
+    for (int i = 0; i < outcomes.size(); ++i) {
+        QCOMPARE(outcomes[i].result, session.ended[i].result);
+        QCOMPARE(outcomes[i].amount, session.ended[i].payout);
+    }
+
+    // A RoundEngine playing the log without delays settles every hand the same way
+    SessionReplayer::Result replay = SessionReplayer::replay(session.log);
+    QVERIFY2(replay.matches, qPrintable(replay.message));
+    QCOMPARE(replay.rounds, rounds);
+    QCOMPARE(replay.outcomesChecked, session.ended.size());
+}
+
+void RoundFlowTest::repeatsSession() {
+    Session first = playSession(200, 2);
+    Session second = playSession(200, 2);
+    QCOMPARE(first.rounds, 200);
+    QCOMPARE(second.endTime, first.endTime);
+    const QVector<SessionLog::Event>& firstEvents = first.log.getEvents();
+    const QVector<SessionLog::Event>& secondEvents = second.log.getEvents();
+    QCOMPARE(secondEvents.size(), firstEvents.size());
+    for (int i = 0; i < firstEvents.size(); ++i) {
+        QCOMPARE(secondEvents[i].type, firstEvents[i].type);
+        QCOMPARE(secondEvents[i].amount, firstEvents[i].amount);
+        QCOMPARE(secondEvents[i].balance, firstEvents[i].balance);
+    }
+}
+
+void RoundFlowTest::destroysGameMidDelay() {
+    VirtualClock clock;
+    auto* game = new BlackjackGame(nullptr, &clock);
+    int dealt = 0;
+    connect(game, &BlackjackGame::playerCardDealt, game, [&dealt](Card, int, bool) { dealt++; });
+
+    // Part way through the initial deal
+    game->beginRound(10);
+    clock.advance(BlackjackGame::DEAL_DELAY);
+    QVERIFY(dealt > 0);
+    QVERIFY(clock.getPendingCount() > 0);
+
+    // The delays are dropped as they come due; a round resumed by one would schedule more
+    int pending = clock.getPendingCount();
+    delete game;
+    QCOMPARE(clock.runUntilIdle(), pending);
+    QCOMPARE(clock.getPendingCount(), 0);
+}
+
+void RoundFlowTest::destroysGameMidInput() {
+    VirtualClock clock;
+    auto* game = new BlackjackGame(nullptr, &clock);
+    int turns = 0;
+    int ended = 0;
+    connect(game, &BlackjackGame::playerTurn, game, [&turns](int, bool, bool, bool) { turns++; });
+    // The test is the context, so the count outlives the game
+    connect(game, &BlackjackGame::roundEnded, this, [&ended](BlackjackGame::GameResult, int, int, int) { ended++; });
+
+    // Deal until a round waits for the player (a blackjack ends a round without one)
+    for (int round = 0; round < 100 && turns == 0; ++round) {
+        game->beginRound(10);
+        clock.runUntilIdle();
+    }
+    QVERIFY(turns > 0);
+    QCOMPARE(clock.getPendingCount(), 0);
+
+    // The waiting round is destroyed with the game, and nothing it scheduled runs
+    int endedBefore = ended;
+    delete game;
+    QCOMPARE(clock.runUntilIdle(), 0);
+    QCOMPARE(ended, endedBefore);
+}
+
+QTEST_GUILESS_MAIN(RoundFlowTest)
+
+#include "round_flow_test.moc"
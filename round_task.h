@@ -0,0 +1,158 @@
+#ifndef ROUND_TASK_H
+#define ROUND_TASK_H
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <utility>
+#include <QObject>
+#include "basic_strategy_checker.h"
+#include "game_clock.h"
+
+/// @brief A round of blackjack written as a coroutine: the steps of the round in order,
+/// with a co_await wherever the round waits, either for a ClockDelay (so the cards can be
+/// animated) or for the player's next action from a PlayerInput. The round starts as soon
+/// as it is called and runs until its first wait; each wait is resumed by the clock or by
+/// PlayerInput::submit, on the caller's stack.
+///
+/// On a RealTimeClock the round plays at animation speed. On a VirtualClock nothing waits
+/// in real time, so a round whose actions are submitted as soon as they are asked for
+/// runs to the end in a single VirtualClock::runUntilIdle.
+///
+/// Destroying the task destroys the round wherever it is waiting. The delays it was
+/// waiting on are dropped, like any clock callback whose context is destroyed.
+class RoundTask {
+public:
+    struct promise_type;
+
+    /// @brief The handle of a round's coroutine.
+    using Handle = std::coroutine_handle<promise_type>;
+
+    /// @brief The state of a round's coroutine, as the compiler requires.
+    struct promise_type {
+        /// @brief The context of the round's delays, destroyed with the round so delays
+        /// never resume a round that is gone.
+        std::unique_ptr<QObject> context = std::make_unique<QObject>();
+
+        RoundTask get_return_object() { return RoundTask(Handle::from_promise(*this)); }
+
+        /// @brief Runs the round as soon as it is called.
+        std::suspend_never initial_suspend() noexcept { return {}; }
+
+        /// @brief Keeps the finished round until the task is destroyed, so isDone can
+        /// tell.
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        void return_void() {}
+
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    /// @brief Creates a task with no round.
+    RoundTask() = default;
+
+    RoundTask(RoundTask&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+
+    RoundTask& operator=(RoundTask&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+
+    RoundTask(const RoundTask&) = delete;
+    RoundTask& operator=(const RoundTask&) = delete;
+
+    ~RoundTask() { destroy(); }
+
+    /// @brief Returns true if the round has run to the end, or there is no round.
+    bool isDone() const { return !handle_ || handle_.done(); }
+
+private:
+    explicit RoundTask(Handle handle) : handle_(handle) {}
+
+    /// @brief Destroys the round, if there is one.
+    void destroy() {
+        if (handle_)
+            std::exchange(handle_, {}).destroy();
+    }
+
+    /// @brief The round, or null.
+    Handle handle_;
+};
+
+/// @brief Makes a round wait for a delay on a GameClock: `co_await ClockDelay(clock, 500)`.
+class ClockDelay {
+public:
+    /// @brief Creates a new ClockDelay.
+    /// @param clock The clock to wait on.
+    /// @param delay The delay, in milliseconds of game time.
+    ClockDelay(GameClock& clock, int delay) : clock_(clock), delay_(delay) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(RoundTask::Handle round) {
+        clock_.schedule(delay_, round.promise().context.get(), [round]() { round.resume(); });
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    /// @brief The clock to wait on.
+    GameClock& clock_;
+
+    /// @brief The delay, in milliseconds of game time.
+    int delay_;
+};
+
+/// @brief Hands the player's actions to the round waiting for them:
+/// `PlayerAction action = co_await input.next()`. Actions submitted while no round is
+/// waiting (during an animation, or between rounds) are ignored.
+class PlayerInput {
+public:
+    using PlayerAction = BasicStrategyChecker::PlayerAction;
+
+    /// @brief Waits for the player's next action.
+    class Next {
+    public:
+        explicit Next(PlayerInput& input) : input_(input) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> round) noexcept { input_.waiting_ = round; }
+
+        PlayerAction await_resume() const noexcept { return input_.action_; }
+
+    private:
+        PlayerInput& input_;
+    };
+
+    /// @brief Makes a round wait for the player's next action.
+    Next next() { return Next(*this); }
+
+    /// @brief Returns true if a round is waiting for an action.
+    bool isAwaited() const { return static_cast<bool>(waiting_); }
+
+    /// @brief Resumes the waiting round with an action, which it runs before this returns.
+    /// @return False if no round was waiting, so the action was ignored.
+    bool submit(PlayerAction action) {
+        if (!waiting_)
+            return false;
+        action_ = action;
+        std::exchange(waiting_, {}).resume();
+        return true;
+    }
+
+    /// @brief Forgets the waiting round, which must be done before it is destroyed.
+    void clear() { waiting_ = {}; }
+
+private:
+    /// @brief The round waiting for an action, or null.
+    std::coroutine_handle<> waiting_;
+
+    /// @brief The action the round is resumed with.
+    PlayerAction action_ = PlayerAction::Stand;
+};
+
+#endif // ROUND_TASK_H
@@ -1,6 +1,8 @@
 #ifndef RULESET_H
 #define RULESET_H
 
+#include "counting_system.h"
+
 struct Ruleset {
     // Dealer Rules
     bool dealerHitsSoft17 = true;     // true = dealer hits on soft 17.
@@ -18,7 +20,9 @@ struct Ruleset {
     bool resplitAces = false;         // can you split if you split aces and get another ace? (Only applicable if hitSplitAces is true)
     bool surrenderAllowed = true;     // Can you give up half your bet after dealer checks for blackjack? Lose the hand and half your bet
 
-    // Add section for player assistances and hints in practice mode
+    // Player assistances and hints in practice mode
+    bool indexPlays = false;          // true = strategy hints include true-count index plays (Illustrious 18, Fab 4).
+    CountingSystem::Id countingSystem = CountingSystem::Id::HiLo; // the count shown while practicing.
 };
 
 #endif // RULESET_H
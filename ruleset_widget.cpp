@@ -5,6 +5,10 @@ RulesetWidget::RulesetWidget(QWidget *parent)
     : QWidget(parent)
     , ui_(new Ui::ruleset_widget) {
     ui_->setupUi(this);
+
+    // List the counting systems in the order of their ids, so the index is the id
+    for (const CountingSystem& system : COUNTING_SYSTEMS)
+        ui_->countingSystem->addItem(system.name);
 }
 
 RulesetWidget::~RulesetWidget() {
@@ -23,6 +27,8 @@ void RulesetWidget::setRuleset(const Ruleset& rules) {
     ui_->checkBox_6->setChecked(rules.hitSplitAces);
     ui_->checkBox_7->setChecked(rules.resplitAces);
     ui_->checkBox_8->setChecked(rules.surrenderAllowed);
+    ui_->checkBox_9->setChecked(rules.indexPlays);
+    ui_->countingSystem->setCurrentIndex(static_cast<int>(rules.countingSystem));
 }
 
 Ruleset RulesetWidget::getRuleset() const {
@@ -38,9 +44,19 @@ Ruleset RulesetWidget::getRuleset() const {
     rules.hitSplitAces = ui_->checkBox_6->isChecked();
     rules.resplitAces = ui_->checkBox_7->isChecked();
     rules.surrenderAllowed = ui_->checkBox_8->isChecked();
+    rules.indexPlays = ui_->checkBox_9->isChecked();
+    rules.countingSystem = static_cast<CountingSystem::Id>(ui_->countingSystem->currentIndex());
     return rules;
 }
 
+double RulesetWidget::getTimeScale() const {
+    return ui_->timeScale->value();
+}
+
+void RulesetWidget::setTimeScale(double timeScale) {
+    ui_->timeScale->setValue(timeScale);
+}
+
 void RulesetWidget::on_saveButton_clicked() {
     emit saveRulesRequested(); // Notify MainWindow to save
 }
@@ -26,6 +26,13 @@ public:
     /// @brief Sets the UI to match the existing ruleset.
     void setRuleset(const Ruleset& rules);
 
+    /// @brief Gets the animation time from the current configuration: 1 is normal speed,
+    /// 0 instant. A display setting, kept apart from the rules.
+    double getTimeScale() const;
+
+    /// @brief Sets the UI to match the existing animation time.
+    void setTimeScale(double timeScale);
+
 signals:
     /// @brief Signals that the user has requested to return to the main menu.
     void returnToMainMenu();
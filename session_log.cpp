@@ -0,0 +1,240 @@
+#include "session_log.h"
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace {
+
+/// @brief The bit of each rule in the packed rule flags, in the order of Ruleset.
+enum RuleFlag : quint16 {
+    DealerHitsSoft17 = 1 << 0,
+    DealerPeeks = 1 << 1,
+    PushOnDealer22 = 1 << 2,
+    DoubleAfterSplit = 1 << 3,
+    Resplit = 1 << 4,
+    HitSplitAces = 1 << 5,
+    ResplitAces = 1 << 6,
+    SurrenderAllowed = 1 << 7,
+    IndexPlays = 1 << 8
+};
+
+/// @brief The position of the counting system in the packed rule flags, after the rules.
+constexpr int COUNTING_SYSTEM_SHIFT = 9;
+
+/// @brief The bits of the counting system in the packed rule flags.
+constexpr quint16 COUNTING_SYSTEM_MASK = 0x7 << COUNTING_SYSTEM_SHIFT;
+
+/// @brief Writes a ruleset as its packed flags, payout, and deck count.
+void writeRuleset(QDataStream& out, const Ruleset& rules) {
+    quint16 flags = (rules.dealerHitsSoft17 ? DealerHitsSoft17 : 0) | (rules.dealerPeeks ? DealerPeeks : 0)
+                    | (rules.pushOnDealer22 ? PushOnDealer22 : 0) | (rules.doubleAfterSplit ? DoubleAfterSplit : 0)
+                    | (rules.resplit ? Resplit : 0) | (rules.hitSplitAces ? HitSplitAces : 0)
+                    | (rules.resplitAces ? ResplitAces : 0) | (rules.surrenderAllowed ? SurrenderAllowed : 0)
+                    | (rules.indexPlays ? IndexPlays : 0)
+                    | (static_cast<quint16>(rules.countingSystem) << COUNTING_SYSTEM_SHIFT);
+    out << flags << rules.blackjackPayout << static_cast<qint32>(rules.numDecks);
+}
+
+/// @brief Reads a ruleset written by writeRuleset.
+Ruleset readRuleset(QDataStream& in) {
+    quint16 flags;
+    qint32 decks;
+    Ruleset rules;
+    in >> flags >> rules.blackjackPayout >> decks;
+    rules.numDecks = decks;
+    rules.dealerHitsSoft17 = flags & DealerHitsSoft17;
+    rules.dealerPeeks = flags & DealerPeeks;
+    rules.pushOnDealer22 = flags & PushOnDealer22;
+    rules.doubleAfterSplit = flags & DoubleAfterSplit;
+    rules.resplit = flags & Resplit;
+    rules.hitSplitAces = flags & HitSplitAces;
+    rules.resplitAces = flags & ResplitAces;
+    rules.surrenderAllowed = flags & SurrenderAllowed;
+    rules.indexPlays = flags & IndexPlays;
+    int system = (flags & COUNTING_SYSTEM_MASK) >> COUNTING_SYSTEM_SHIFT;
+    if (system < CountingSystem::COUNT)
+        rules.countingSystem = static_cast<CountingSystem::Id>(system);
+    return rules;
+}
+
+/// @brief Writes the header of a session file: everything but the events.
+void writeHeader(QDataStream& out, const SessionLog& log) {
+    out << SessionLog::FILE_MAGIC << SessionLog::FILE_VERSION << log.getSeed()
+        << static_cast<qint32>(log.getStartingBalance());
+    writeRuleset(out, log.getRuleset());
+}
+
+/// @brief Writes one event: its type, followed by only the fields that type uses.
+void writeEvent(QDataStream& out, const SessionLog& log, const SessionLog::Event& event) {
+    out << static_cast<quint8>(event.type);
+    switch (event.type) {
+    case SessionLog::EventType::Bet:
+    case SessionLog::EventType::Shuffle:
+        out << event.amount;
+        break;
+    case SessionLog::EventType::RulesetChange:
+        writeRuleset(out, log.getRuleset(event.amount));
+        break;
+    case SessionLog::EventType::Outcome:
+        out << static_cast<quint8>(event.result) << event.amount << event.balance;
+        break;
+    default:
+        break;
+    }
+}
+
+}
+
+SessionLog::SessionLog() : seed_(0), startingBalance_(0), rulesets_(1) {}
+
+SessionLog::SessionLog(quint64 seed, const Ruleset& rules, int startingBalance) :
+    seed_(seed), startingBalance_(startingBalance), rulesets_{ rules } {}
+
+void SessionLog::recordBet(int amount) {
+    append(EventType::Bet, amount);
+}
+
+void SessionLog::recordAction(EventType type) {
+    append(type);
+}
+
+void SessionLog::recordShuffle(bool needsShuffling) {
+    append(EventType::Shuffle, needsShuffling);
+}
+
+void SessionLog::recordRuleset(const Ruleset& rules) {
+    rulesets_.append(rules);
+    append(EventType::RulesetChange, rulesets_.size() - 1);
+}
+
+void SessionLog::recordDraw() {
+    append(EventType::Draw);
+}
+
+void SessionLog::recordOutcome(const RoundEngine::HandOutcome& outcome, int balance) {
+    events_.append({ EventType::Outcome, outcome.result, outcome.payout, balance });
+}
+
+void SessionLog::append(EventType type, qint32 amount) {
+    events_.append({ type, RoundEngine::GameResult::Push, amount, 0 });
+}
+
+QString SessionLog::getDefaultPath() const {
+    QDir directory(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+    return directory.filePath(QString("sessions/session-%1.bjlog").arg(seed_, 16, 16, QChar('0')));
+}
+
+bool SessionLog::load(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    quint32 magic;
+    quint16 version;
+    quint64 seed;
+    qint32 startingBalance;
+    in >> magic >> version >> seed >> startingBalance;
+    if (in.status() != QDataStream::Ok || magic != FILE_MAGIC || version != FILE_VERSION)
+        return false;
+
+    QVector<Ruleset> rulesets { readRuleset(in) };
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    // Each event is its type, followed by only the fields that type uses. An event cut
+    // short by the end of the file was torn by a crash, and is dropped
+    QVector<Event> events;
+    while (!in.atEnd()) {
+        quint8 type;
+        in >> type;
+        if (type > static_cast<quint8>(EventType::Outcome))
+            return false;
+        Event event { static_cast<EventType>(type), RoundEngine::GameResult::Push, 0, 0 };
+        Ruleset rules;
+        quint8 result = 0;
+        switch (event.type) {
+        case EventType::Bet:
+        case EventType::Shuffle:
+            in >> event.amount;
+            break;
+        case EventType::RulesetChange:
+            rules = readRuleset(in);
+            break;
+        case EventType::Outcome:
+            in >> result >> event.amount >> event.balance;
+            break;
+        default:
+            break;
+        }
+        if (in.status() != QDataStream::Ok)
+            break;
+
+        if (event.type == EventType::RulesetChange) {
+            rulesets.append(rules);
+            event.amount = rulesets.size() - 1;
+        }
+        if (event.type == EventType::Outcome) {
+            if (result > static_cast<quint8>(RoundEngine::GameResult::Surrender))
+                return false;
+            event.result = static_cast<RoundEngine::GameResult>(result);
+        }
+        events.append(event);
+    }
+
+    seed_ = seed;
+    startingBalance_ = startingBalance;
+    rulesets_ = rulesets;
+    events_ = events;
+    return true;
+}
+
+bool SessionLog::save(const QString& path) const {
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    writeHeader(out, *this);
+    for (const Event& event : events_)
+        writeEvent(out, *this, event);
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+SessionLogWriter::SessionLogWriter() : eventsWritten_(0) {}
+
+bool SessionLogWriter::open(const QString& path, const SessionLog& log) {
+    file_.close();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    file_.setFileName(path);
+    if (!file_.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    QDataStream out(&file_);
+    writeHeader(out, log);
+    eventsWritten_ = 0;
+    if (out.status() != QDataStream::Ok || !write(log)) {
+        file_.close();
+        return false;
+    }
+    return true;
+}
+
+bool SessionLogWriter::isOpen() const {
+    return file_.isOpen();
+}
+
+bool SessionLogWriter::write(const SessionLog& log) {
+    if (!file_.isOpen())
+        return false;
+
+    QDataStream out(&file_);
+    const QVector<SessionLog::Event>& events = log.getEvents();
+    for (; eventsWritten_ < events.size(); ++eventsWritten_)
+        writeEvent(out, log, events[eventsWritten_]);
+    return out.status() == QDataStream::Ok && file_.flush();
+}
@@ -0,0 +1,172 @@
+#ifndef SESSION_LOG_H
+#define SESSION_LOG_H
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include "round_engine.h"
+#include "ruleset.h"
+
+/// @brief A record of a game session from which it can be replayed exactly: the seed the
+/// shoe was shuffled from, the rules and balance it started with, and every call that
+/// changed the game, in order (bets, player actions, shuffles, and rule changes). The
+/// outcome of each settled hand and the balance after it are recorded too, so a replay can
+/// check that it reaches the same results (see SessionReplayer).
+///
+/// Player actions are recorded at the RoundEngine level, as they are applied: an action
+/// that is ignored (e.g., a hit after the hand is complete) is not recorded, and the stand
+/// the game makes on its own after a double or a hit to 21 is.
+class SessionLog {
+public:
+    /// @brief The kinds of event in a session.
+    enum class EventType : quint8 {
+        /// @brief A round began with a bet of amount.
+        Bet,
+        Hit,
+        Stand,
+        Double,
+        Split,
+        Surrender,
+        /// @brief The shoe was marked for shuffling (amount 1) or unmarked (amount 0).
+        Shuffle,
+        /// @brief The rules changed to getRuleset(amount).
+        RulesetChange,
+        /// @brief A card was drawn from the shoe outside of a round.
+        Draw,
+        /// @brief A hand was settled with result, paying amount, leaving balance.
+        Outcome
+    };
+
+    /// @brief One event of a session.
+    struct Event {
+        /// @brief The kind of event.
+        EventType type;
+
+        /// @brief For Outcome, the result of the hand.
+        RoundEngine::GameResult result;
+
+        /// @brief The bet, payout, shuffle flag, or ruleset index, depending on the type.
+        qint32 amount;
+
+        /// @brief For Outcome, the player's balance after the hand was settled.
+        qint32 balance;
+    };
+
+    /// @brief The first four bytes of a session file ("BJSL").
+    static constexpr quint32 FILE_MAGIC = 0x424A534C;
+
+    /// @brief The version of the session file format. Version 2 drops the event count
+    /// from the header, so events can be appended (see SessionLogWriter).
+    static constexpr quint16 FILE_VERSION = 2;
+
+    /// @brief Creates an empty log, for loading into.
+    SessionLog();
+
+    /// @brief Creates a log for a new session.
+    /// @param seed The seed the shoe was shuffled from (see RoundEngine::seedShoe).
+    /// @param rules The rules the session started with.
+    /// @param startingBalance The player's balance at the start of the session.
+    SessionLog(quint64 seed, const Ruleset& rules, int startingBalance);
+
+    /// @brief Gets the seed the shoe was shuffled from.
+    quint64 getSeed() const { return seed_; }
+
+    /// @brief Gets the player's balance at the start of the session.
+    int getStartingBalance() const { return startingBalance_; }
+
+    /// @brief Gets a ruleset used in the session. Ruleset 0 is the one the session started
+    /// with; the rest are referred to by RulesetChange events.
+    const Ruleset& getRuleset(int index = 0) const { return rulesets_[index]; }
+
+    /// @brief Gets every event of the session, in order.
+    const QVector<Event>& getEvents() const { return events_; }
+
+    /// @brief Records the start of a round.
+    void recordBet(int amount);
+
+    /// @brief Records a player action that was applied.
+    /// @param type One of Hit, Stand, Double, Split, or Surrender.
+    void recordAction(EventType type);
+
+    /// @brief Records that the shoe was marked (or unmarked) for shuffling.
+    void recordShuffle(bool needsShuffling);
+
+    /// @brief Records a change of rules.
+    void recordRuleset(const Ruleset& rules);
+
+    /// @brief Records a card drawn from the shoe outside of a round.
+    void recordDraw();
+
+    /// @brief Records a settled hand.
+    /// @param outcome The outcome of the hand.
+    /// @param balance The player's balance after the hand was settled.
+    void recordOutcome(const RoundEngine::HandOutcome& outcome, int balance);
+
+    /// @brief Gets the path the session is saved to by default: a file named after the
+    /// seed in the application's data directory.
+    QString getDefaultPath() const;
+
+    /// @brief Reads a log from a file. The events run to the end of the file; a last event
+    /// cut short (by a crash while it was being appended) is left out.
+    /// @param path The path of the file.
+    /// @return True if the file exists and holds a valid log.
+    bool load(const QString& path);
+
+    /// @brief Writes the log to a file, replacing it atomically. Directories in the path
+    /// are created as needed.
+    /// @param path The path of the file.
+    /// @return True if the file was written.
+    bool save(const QString& path) const;
+
+private:
+    /// @brief Adds an event.
+    void append(EventType type, qint32 amount = 0);
+
+    /// @brief The seed the shoe was shuffled from.
+    quint64 seed_;
+
+    /// @brief The player's balance at the start of the session.
+    int startingBalance_;
+
+    /// @brief The session's rulesets, starting with the one it began with.
+    QVector<Ruleset> rulesets_;
+
+    /// @brief Every event of the session, in order.
+    QVector<Event> events_;
+};
+
+/// @brief Keeps a session's file up to date as the session is played. Opening the file
+/// writes the log so far; after that, each write appends only the events recorded since
+/// the last one, so saving after every round costs the size of the round rather than of
+/// the whole session. A crash loses at most the events since the last write.
+class SessionLogWriter {
+public:
+    /// @brief Creates a writer with no file open.
+    SessionLogWriter();
+
+    /// @brief Creates (or replaces) a file and writes the log so far to it. Directories
+    /// in the path are created as needed.
+    /// @param path The path of the file.
+    /// @param log The log to write. Later writes must be of the same log.
+    /// @return True if the file is open and the log was written.
+    bool open(const QString& path, const SessionLog& log);
+
+    /// @brief Returns true if a file is open.
+    bool isOpen() const;
+
+    /// @brief Appends the events recorded since the last write and flushes them to the
+    /// file.
+    /// @param log The log the file was opened with.
+    /// @return True if every new event was written.
+    bool write(const SessionLog& log);
+
+private:
+    /// @brief The open file.
+    QFile file_;
+
+    /// @brief The number of the log's events in the file.
+    int eventsWritten_;
+};
+
+#endif // SESSION_LOG_H
@@ -0,0 +1,116 @@
+#include "session_replayer.h"
+#include "round_engine.h"
+#include "work_stealing_scheduler.h"
+
+namespace {
+
+using EventType = SessionLog::EventType;
+
+/// @brief A hand settled by the replay, waiting to be checked against the recorded
+/// outcome.
+struct SettledHand {
+    RoundEngine::HandOutcome outcome;
+    int balance;
+};
+
+}
+
+SessionReplayer::Result SessionReplayer::replay(const SessionLog& log) {
+    Result result;
+    RoundEngine engine(log.getRuleset(), log.getStartingBalance());
+    engine.seedShoe(log.getSeed());
+
+    // Hands are settled by the replay before the session recorded them (the session waits
+    // between hands), so they queue up until their Outcome events are reached
+    QVector<SettledHand> settled;
+    int nextToCheck = 0;
+    auto settle = [&engine, &settled](int handIndex) {
+        RoundEngine::HandOutcome outcome = engine.settleHand(handIndex);
+        settled.append({ outcome, engine.getBalance() });
+    };
+
+    const QVector<SessionLog::Event>& events = log.getEvents();
+    for (int i = 0; i < events.size(); ++i) {
+        const SessionLog::Event& event = events[i];
+        switch (event.type) {
+        case EventType::Bet:
+            engine.startRound(event.amount);
+            engine.dealInitialCards();
+            if (engine.checkForBlackjacks())
+                settle(0);
+            result.rounds++;
+            break;
+        case EventType::Hit:
+            engine.hit();
+            break;
+        case EventType::Stand:
+            if (!engine.stand() && engine.getPhase() == RoundEngine::Phase::DealerTurn) {
+                engine.playDealerHand();
+                for (int hand = 0; hand < engine.getHandCount(); ++hand)
+                    settle(hand);
+            }
+            break;
+        case EventType::Double:
+            engine.doubleDown();
+            break;
+        case EventType::Split:
+            engine.split();
+            break;
+        case EventType::Surrender: {
+            RoundEngine::HandOutcome outcome = engine.surrender();
+            settled.append({ outcome, engine.getBalance() });
+            break;
+        }
+        case EventType::Shuffle:
+            engine.setNeedsShuffling(event.amount != 0);
+            break;
+        case EventType::RulesetChange:
+            engine.setRuleset(log.getRuleset(event.amount));
+            break;
+        case EventType::Draw:
+            engine.drawCard();
+            break;
+        case EventType::Outcome: {
+            if (nextToCheck == settled.size()) {
+                result.message = QString("Event %1: a hand was settled in the session but not in the replay").arg(i);
+            }
+            else {
+                const SettledHand& hand = settled[nextToCheck++];
+                if (hand.outcome.result != event.result || hand.outcome.payout != event.amount
+                    || hand.balance != event.balance) {
+                    result.message = QString("Event %1: the session paid %2 leaving %3, but the replay paid %4 leaving %5")
+                                         .arg(i).arg(event.amount).arg(event.balance)
+                                         .arg(hand.outcome.payout).arg(hand.balance);
+                }
+            }
+            if (!result.message.isEmpty()) {
+                result.matches = false;
+                result.mismatchEvent = i;
+                result.finalBalance = engine.getBalance();
+                return result;
+            }
+            result.outcomesChecked++;
+            break;
+        }
+        }
+    }
+
+    result.finalBalance = engine.getBalance();
+    return result;
+}
+
+QVector<SessionReplayer::Result> SessionReplayer::replayFiles(const QStringList& paths, int threads) {
+    QVector<Result> results(paths.size());
+    WorkStealingScheduler scheduler;
+    scheduler.run(paths.size(), threads, [&paths, &results](int, qint64 index) {
+        SessionLog log;
+        if (log.load(paths[index])) {
+            results[index] = replay(log);
+        }
+        else {
+            results[index].matches = false;
+            results[index].message = "The file could not be read";
+        }
+    });
+    return results;
+}
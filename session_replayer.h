@@ -0,0 +1,53 @@
+#ifndef SESSION_REPLAYER_H
+#define SESSION_REPLAYER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "session_log.h"
+
+/// @brief Replays recorded sessions with a RoundEngine, with no timers or UI, and checks
+/// that every hand settles with the same result, payout, and balance as it did in the
+/// session.
+///
+/// A replay makes the same engine calls BlackjackGame made, in the same order, from a
+/// shoe seeded the same way. The round steps BlackjackGame plays between delays on its
+/// clock (the initial deal, the dealer's turn, and settling each hand) are not recorded,
+/// since they follow from the events before them, and are run as soon as they are due.
+class SessionReplayer {
+public:
+    /// @brief The result of replaying one session.
+    struct Result {
+        /// @brief True if the replay settled every recorded hand the same way.
+        bool matches = true;
+
+        /// @brief The number of rounds replayed.
+        int rounds = 0;
+
+        /// @brief The number of recorded hand outcomes that were checked.
+        int outcomesChecked = 0;
+
+        /// @brief The player's balance at the end of the replay.
+        int finalBalance = 0;
+
+        /// @brief The index of the first event that did not match, or -1.
+        int mismatchEvent = -1;
+
+        /// @brief Describes the first mismatch, if there was one.
+        QString message;
+    };
+
+    /// @brief Replays a session.
+    /// @param log The session to replay.
+    /// @return The result of the replay.
+    static Result replay(const SessionLog& log);
+
+    /// @brief Loads and replays many sessions at once, spread over several threads.
+    /// @param paths The paths of the session files.
+    /// @param threads The number of threads to replay on (at least 1).
+    /// @return The result for each path, in the same order. A file that cannot be read
+    /// does not match.
+    static QVector<Result> replayFiles(const QStringList& paths, int threads);
+};
+
+#endif // SESSION_REPLAYER_H
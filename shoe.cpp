@@ -1,39 +1,115 @@
 #include "shoe.h"
-#include <QTime>
+#include <utility>
 
-Shoe::Shoe(int decks, float penetration, QObject* parent) :
-    QObject{parent}, decks_(decks), penetration_(penetration),
-    cards_(), rng_(QTime::currentTime().msecsSinceStartOfDay()) {
-    shuffle();
+Shoe::Shoe(int decks, float penetration) :
+    decks_(decks), penetration_(penetration),
+    cards_(), next_(0), cutPosition_(0), rankCounts_(), rng_(std::make_unique<Xoshiro256>()) {
+    build();
 }
 
-Card Shoe::draw() {
-    Card result = cards_.last();
-    cards_.removeLast();
-    return result;
+Shoe::Shoe(const Shoe& other) :
+    decks_(other.decks_), penetration_(other.penetration_), cards_(other.cards_), next_(other.next_),
+    cutPosition_(other.cutPosition_), rankCounts_(other.rankCounts_), rng_(other.rng_->clone())
+{}
+
+Shoe& Shoe::operator=(const Shoe& other) {
+    if (this != &other) {
+        decks_ = other.decks_;
+        penetration_ = other.penetration_;
+        cards_ = other.cards_;
+        next_ = other.next_;
+        cutPosition_ = other.cutPosition_;
+        rankCounts_ = other.rankCounts_;
+        rng_ = other.rng_->clone();
+    }
+    return *this;
 }
 
 size_t Shoe::getSize() const {
-    return cards_.size();
+    return cards_.size() - next_;
+}
+
+int Shoe::getDealtCount() const {
+    return next_;
+}
+
+int Shoe::getCutPosition() const {
+    return cutPosition_;
+}
+
+int Shoe::getRemainingWithValue(int value) const {
+    if (value == 10) {
+        return rankCounts_[static_cast<int>(Card::Rank::Ten)] + rankCounts_[static_cast<int>(Card::Rank::Jack)]
+            + rankCounts_[static_cast<int>(Card::Rank::Queen)] + rankCounts_[static_cast<int>(Card::Rank::King)];
+    }
+    // Aces (11) are rank 1, and the ranks 2-9 match their values
+    return rankCounts_[value == 11 ? static_cast<int>(Card::Rank::Ace) : value];
+}
+
+Composition Shoe::getComposition() const {
+    Composition composition;
+    for (int value = 2; value <= 11; ++value) {
+        int index = value == 11 ? 0 : value - 1;
+        composition.setCount(index, getRemainingWithValue(value));
+    }
+    return composition;
+}
+
+double Shoe::getDecksRemaining() const {
+    return getSize() / 52.0;
 }
 
 void Shoe::shuffle() {
+    // The shoe always holds the same cards, so they only need to be reordered
+    randomize();
+    next_ = 0;
+    rankCounts_.fill(decks_ * 4);
+    rankCounts_[static_cast<int>(Card::Rank::Cut)] = 0;
+}
+
+void Shoe::setDecks(int decks) {
+    decks_ = decks;
+    build();
+}
+
+void Shoe::seed(quint64 seed, quint64 stream) {
+    rng_->seed(seed, stream);
+    restoreOrder();
+    shuffle();
+}
+
+void Shoe::setRandomSource(std::unique_ptr<RandomSource> rng) {
+    rng_ = std::move(rng);
+}
+
+void Shoe::build() {
     cards_.clear();
-    for (int i = 0; i < decks_; ++i)
-        addDeck();
-    randomize(cards_, rng_);
-    int cutCardPosition = static_cast<int>(cards_.size() * penetration_);
-    cards_.insert(cutCardPosition, Card(Card::Rank::Cut, Card::Suit::Cut));
-}
-
-void Shoe::addDeck() {
-    for (int suitInt = 0; suitInt < 4; ++suitInt) {
-        for (int rankInt = 1; rankInt < 14; ++rankInt)
-            cards_.append(Card(static_cast<Card::Rank>(rankInt),
-                               static_cast<Card::Suit>(suitInt)));
-    }
+    cards_.reserve(decks_ * 52);
+    for (int i = 0; i < decks_ * 52; ++i)
+        cards_.append(unshuffledCard(i));
+
+    int size = cards_.size();
+    cutPosition_ = size - static_cast<int>(size * penetration_);
+    shuffle();
+}
+
+void Shoe::reseedUndealt(quint64 seed, quint64 stream) {
+    rng_->seed(seed, stream);
+    for (int i = cards_.size() - 1; i > next_; --i)
+        std::swap(cards_[i], cards_[next_ + rng_->bounded(i - next_ + 1)]);
+}
+
+void Shoe::randomize() {
+    for (int i = cards_.size() - 1; i > 0; --i)
+        std::swap(cards_[i], cards_[rng_->bounded(i + 1)]);
+}
+
+void Shoe::restoreOrder() {
+    for (int i = 0; i < cards_.size(); ++i)
+        cards_[i] = unshuffledCard(i);
 }
 
-void Shoe::randomize(QVector<Card>& list, QRandomGenerator& rng) {
-    std::shuffle(list.begin(), list.end(), rng);
+Card Shoe::unshuffledCard(int index) {
+    return Card(static_cast<Card::Rank>(index % 13 + 1),
+                static_cast<Card::Suit>(index / 13 % 4));
 }
@@ -1,57 +1,156 @@
 #ifndef SHOE_H
 #define SHOE_H
 
-#include <QObject>
+#include <array>
+#include <memory>
 #include <QVector>
-#include <QRandomGenerator>
 #include "card.h"
+#include "composition.h"
+#include "random_source.h"
 
-/// @brief A class representing the shoe that holds the cards to be drawn.
-class Shoe : public QObject {
-    Q_OBJECT
+/// @brief A class representing the shoe that holds the cards to be drawn. Every card is
+/// allocated once, at construction; shuffling reorders them in place, and cards are dealt
+/// by advancing a cursor. The cut card is not stored in the shoe, but tracked as the
+/// number of cards that are dealt before it is reached. Shuffles are drawn from a
+/// RandomSource, which is a seeded Xoshiro256 unless another source is provided. The shoe
+/// also keeps a count of the undealt cards of each rank, updated on every draw.
+class Shoe {
 public:
     /// @brief Constructs a new Shoe.
     /// @param decks The number of full decks of cards in the shoe (default 6).
     /// @param penetration The location of the cut card relative to the rest of the
-    /// shoe.
-    /// @param parent The parent object of this Shoe object.
-    Shoe(int decks = 6, float penetration = 0.2, QObject* parent = nullptr);
+    /// shoe; i.e., the fraction of the cards that are left undealt once it is reached.
+    Shoe(int decks = 6, float penetration = 0.2);
 
-    /// @brief Draws a card from the shoe.
+    /// @brief Copies a shoe, including its order and the state of its random source, so
+    /// the copy deals exactly the same cards as the original.
+    Shoe(const Shoe& other);
+
+    /// @brief Copies a shoe (see the copy constructor).
+    Shoe& operator=(const Shoe& other);
+
+    Shoe(Shoe&&) = default;
+    Shoe& operator=(Shoe&&) = default;
+
+    /// @brief Draws a card from the shoe. If every card has been dealt, the shoe is
+    /// shuffled first.
     /// @return The card drawn from the shoe.
-    Card draw();
+    Card draw() {
+        if (next_ == cards_.size())
+            shuffle();
+        Card card = cards_.at(next_++);
+        --rankCounts_[static_cast<int>(card.rank)];
+        return card;
+    }
+
+    /// @brief Returns true if the next card to be drawn is the first card after the cut
+    /// card; i.e., the cut card is about to be reached. This is true for exactly one draw
+    /// between shuffles.
+    bool isAtCutCard() const {
+        return next_ == cutPosition_;
+    }
 
     /// @brief Gets the number of cards remaining in the shoe.
     /// @return The number of cards remaining in the shoe.
     size_t getSize() const;
 
-    /// @brief Resets the shoe, giving it the number of decks and penetration provided at
-    /// construction and reordering all cards.
+    /// @brief Gets the number of cards dealt since the last shuffle.
+    int getDealtCount() const;
+
+    /// @brief Gets the number of cards dealt from a fresh shoe before the cut card is
+    /// reached.
+    int getCutPosition() const;
+
+    /// @brief Gets the number of undealt cards of each rank, indexed by rank. The count for
+    /// Card::Rank::Cut is always 0.
+    const std::array<int, Card::RANK_COUNT>& getRankCounts() const {
+        return rankCounts_;
+    }
+
+    /// @brief Gets the number of undealt cards of the given rank.
+    int getRemaining(Card::Rank rank) const {
+        return rankCounts_[static_cast<int>(rank)];
+    }
+
+    /// @brief Gets the number of undealt cards with the given blackjack value (see
+    /// Card::getBlackjackValue), counting tens and face cards together.
+    /// @param value A value from 2 to 11.
+    int getRemainingWithValue(int value) const;
+
+    /// @brief Gets the number of undealt cards of each blackjack value.
+    Composition getComposition() const;
+
+    /// @brief Gets the number of decks left to deal, as a fraction.
+    double getDecksRemaining() const;
+
+    /// @brief Returns every card to the shoe and reorders them. No memory is allocated.
     void shuffle();
 
+    /// @brief Changes the number of decks in the shoe, rebuilding and shuffling it. The
+    /// random source is kept.
+    /// @param decks The new number of decks.
+    void setDecks(int decks);
+
+    /// @brief Reseeds the random source used for shuffling and reshuffles the shoe from
+    /// its unshuffled order. Shoes seeded with the same seed and stream produce the same
+    /// sequence of shuffles on every platform.
+    /// @param seed The new seed.
+    /// @param stream The stream of the seed to use. Shoes on different streams shuffle
+    /// independently, even if they share a seed.
+    void seed(quint64 seed, quint64 stream = 0);
+
+    /// @brief Reseeds the random source and reorders only the undealt cards. The dealt
+    /// cards, the counts of undealt cards, and the cut card are unchanged, so to a player
+    /// who has seen the dealt cards the shoe is just as likely to be in any order as
+    /// before. Copies of a shoe reseeded on different streams deal independent futures
+    /// from the same point in the shoe.
+    /// @param seed The new seed.
+    /// @param stream The stream of the seed to use.
+    void reseedUndealt(quint64 seed, quint64 stream);
+
+    /// @brief Replaces the random source used for shuffling.
+    /// @param rng The new random source. Must not be null.
+    void setRandomSource(std::unique_ptr<RandomSource> rng);
+
 private:
-    /// @brief The number of decks in the shoe before any cards are drawn. Used for shuffling
-    /// the deck.
-    const int decks_;
+    /// @brief The number of decks in the shoe.
+    int decks_;
 
-    /// @brief The location of the cut card relative to the rest of the shoe. Used for shuffling
-    /// the deck.
-    const float penetration_;
+    /// @brief The location of the cut card relative to the rest of the shoe.
+    float penetration_;
 
-    /// @brief The cards in the shoe.
+    /// @brief Every card in the shoe, in the order they will be dealt.
     QVector<Card> cards_;
 
-    /// @brief The random number generator for shuffling cards.
-    QRandomGenerator rng_;
+    /// @brief The index in cards_ of the next card to deal.
+    int next_;
+
+    /// @brief The number of cards dealt before the cut card is reached.
+    int cutPosition_;
+
+    /// @brief The number of undealt cards of each rank, indexed by rank.
+    std::array<int, Card::RANK_COUNT> rankCounts_;
+
+    /// @brief The random source for shuffling cards.
+    std::unique_ptr<RandomSource> rng_;
+
+    /// @brief Fills the shoe with decks_ decks and places the cut card.
+    void build();
+
+    /// @brief Puts every card back in the order the shoe was built in, without
+    /// allocating. Shuffling reorders the cards in place, so this makes the shuffles
+    /// after a reseed independent of the shoe's earlier history.
+    void restoreOrder();
 
-    /// @brief Randomizes the order of all cards in the given list.
-    /// @param list The list of cards to randomize.
-    /// @param rng The random number generator for randomizing the cards.
-    static void randomize(QVector<Card>& list, QRandomGenerator& rng);
+    /// @brief Randomizes the order of all cards in the shoe with a Fisher-Yates shuffle.
+    /// Unlike std::shuffle, the order depends only on the random source, not on the
+    /// standard library implementation.
+    void randomize();
 
-    /// @brief Adds a single deck to the shoe's cards. The cards are sorted in order of rank,
-    /// then in order of suit.
-    void addDeck();
+    /// @brief Gets the card at the given position of an unshuffled shoe. Each deck is
+    /// sorted in order of suit, then in order of rank.
+    /// @param index The position in the shoe.
+    static Card unshuffledCard(int index);
 };
 
 #endif // SHOE_H
@@ -0,0 +1,453 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QRandomGenerator>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <thread>
+#include "bankroll_simulator.h"
+#include "decision_export.h"
+#include "house_edge_simulator.h"
+#include "risk_of_ruin_estimator.h"
+#include "ruleset.h"
+#include "session_replayer.h"
+#include "strategy_tournament.h"
+
+namespace {
+
+/// @brief Formats a fraction as a percentage with a 95% confidence interval.
+QString formatPercent(double value, double margin) {
+    return QString("%1% +/- %2%").arg(value * 100, 0, 'f', 4).arg(margin * 100, 0, 'f', 4);
+}
+
+/// @brief Reads an option that counts something, which must be a whole number from 1 to the
+/// largest the count can hold.
+/// @param count Receives the count if it is valid.
+/// @return True if the count is valid; otherwise the error is written to out.
+template <typename Count>
+bool readCount(const QCommandLineParser& parser, const QCommandLineOption& option, Count& count, QTextStream& out) {
+    bool ok = false;
+    qint64 value = parser.value(option).toLongLong(&ok);
+    if (!ok || value < 1 || value > std::numeric_limits<Count>::max()) {
+        out << "Invalid --" << option.names().first() << " " << parser.value(option)
+            << " (expected a whole number from 1 to " << std::numeric_limits<Count>::max() << ")\n";
+        return false;
+    }
+    count = static_cast<Count>(value);
+    return true;
+}
+
+/// @brief Runs a simulation on another thread, so this one can report progress and
+/// enforce the time limit.
+/// @param simulator The simulator, which must have getProgress, getRoundsPlayed, and
+/// cancel.
+/// @param simulate Runs the simulation.
+/// @param timer Started when the simulation was requested.
+/// @param timeLimit The time limit in milliseconds, or -1 for none.
+/// @param showProgress True to show progress on stderr.
+template <typename Simulator, typename Simulate>
+void runWithProgress(Simulator& simulator, Simulate simulate, const QElapsedTimer& timer, qint64 timeLimit,
+                     bool showProgress) {
+    std::atomic<bool> finished(false);
+    std::thread simulation([&]() {
+        simulate();
+        finished = true;
+    });
+    QTextStream err(stderr);
+    while (!finished) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        if (timeLimit >= 0 && timer.elapsed() >= timeLimit)
+            simulator.cancel();
+        if (showProgress) {
+            err << QString("\r%1% (%2 rounds)").arg(simulator.getProgress() * 100, 0, 'f', 1)
+                                              .arg(simulator.getRoundsPlayed());
+            err.flush();
+        }
+    }
+    simulation.join();
+    if (showProgress)
+        err << "\n";
+}
+
+/// @brief Reads bet ramps from the command line.
+/// @return True if every ramp was valid.
+bool parseRamps(const QStringList& rampTexts, QVector<BetRamp>& ramps, QTextStream& out) {
+    for (const QString& text : rampTexts) {
+        BetRamp ramp;
+        if (!BetRamp::parse(text, ramp)) {
+            out << "Invalid bet ramp " << text << " (expected min-max:start:step[:out:in][@system])\n";
+            return false;
+        }
+        ramps.append(ramp);
+    }
+    return true;
+}
+
+/// @brief Estimates the risk of ruin of one or more bet ramps by multilevel splitting.
+/// @return The exit code: 0 on success, 1 if a ramp could not be read.
+int estimateRuin(const Ruleset& rules, const QStringList& rampTexts, qint64 horizonRounds, int bankrollUnits,
+                 int levelCount, int trialsPerLevel, int replications, int threads, quint64 seed,
+                 const HouseEdgeSimulator::StrategyFactory& strategyFactory, qint64 timeLimit, bool showProgress,
+                 QTextStream& out) {
+    QVector<BetRamp> ramps;
+    if (!parseRamps(rampTexts, ramps, out))
+        return 1;
+
+    out << "Estimating the risk of ruin within " << horizonRounds << " rounds from a bankroll of " << bankrollUnits
+        << " units (" << levelCount << " levels, " << trialsPerLevel << " trials per level, " << replications
+        << " replications) on " << threads << " threads (seed " << seed << ")...\n";
+    out.flush();
+
+    QElapsedTimer timer;
+    timer.start();
+    for (const BetRamp& ramp : ramps) {
+        RiskOfRuinEstimator estimator(rules, ramp, strategyFactory);
+        RuinEstimate estimate;
+        runWithProgress(estimator, [&]() {
+            estimate = estimator.estimate(bankrollUnits, horizonRounds, levelCount, trialsPerLevel, replications,
+                                          threads, seed);
+        }, timer, timeLimit, showProgress);
+
+        out << "\nBet ramp " << ramp.toString() << "\n";
+        if (estimator.isCancelled())
+            out << "  Stopped at the time limit after " << estimate.replications << " replications.\n";
+        out << "  Risk of ruin:    " << formatPercent(estimate.probability, estimate.margin()) << "\n";
+        out << "  By level:       ";
+        for (double probability : estimate.levelProbabilities)
+            out << " " << QString::number(probability, 'f', 3);
+        out << "\n";
+        out << "  Rounds played:   " << estimate.roundsPlayed << " (plain simulation would need at least "
+            << QString::number(estimate.getPlainRoundsNeeded(horizonRounds), 'g', 3) << ")\n";
+        if (estimator.isCancelled())
+            break;
+    }
+    out << "\nElapsed: " << QString::number(timer.elapsed() / 1000.0, 'f', 2) << " s\n";
+    return 0;
+}
+
+/// @brief Simulates bankroll sessions for one or more bet ramps and reports each ramp's
+/// win rate, risk, and bankroll trajectory.
+/// @return The exit code: 0 on success, 1 if a ramp could not be read.
+int simulateBankroll(const Ruleset& rules, const QStringList& rampTexts, qint64 sessions, qint64 roundsPerSession,
+                     int bankrollUnits, int threads, quint64 seed,
+                     const HouseEdgeSimulator::StrategyFactory& strategyFactory, qint64 timeLimit,
+                     bool showProgress, QTextStream& out) {
+    QVector<BetRamp> ramps;
+    if (!parseRamps(rampTexts, ramps, out))
+        return 1;
+
+    out << "Simulating " << sessions << " sessions of " << roundsPerSession << " rounds with a bankroll of "
+        << bankrollUnits << " units for " << ramps.size() << " bet ramps on " << threads << " threads (seed "
+        << seed << ")...\n";
+    out.flush();
+
+    QElapsedTimer timer;
+    timer.start();
+    BankrollSimulator simulator(rules, ramps, strategyFactory);
+    QVector<BankrollStats> results;
+    runWithProgress(simulator, [&]() {
+        results = simulator.run(sessions, roundsPerSession, bankrollUnits, threads, seed);
+    }, timer, timeLimit, showProgress);
+    double seconds = timer.elapsed() / 1000.0;
+    if (simulator.isCancelled())
+        out << "Stopped at the time limit after " << simulator.getRoundsPlayed() << " rounds.\n";
+
+    for (int i = 0; i < ramps.size(); ++i) {
+        const BankrollStats& stats = results[i];
+        out << "\nBet ramp " << ramps[i].toString() << "\n";
+        out << "  Rounds played:   " << stats.rounds << " (" << stats.roundsSatOut << " sat out)\n";
+        out << "  Average bet:     " << QString::number(stats.averageBet(), 'f', 3) << " units\n";
+        out << "  Win rate:        " << QString::number(stats.winRatePer100(), 'f', 3) << " units per 100 rounds\n";
+        out << "  SD:              " << QString::number(stats.standardDeviationPer100(), 'f', 3) << " units per 100 rounds\n";
+        out << "  N0:              " << QString::number(stats.n0(), 'f', 0) << " rounds\n";
+        out << "  SCORE:           " << QString::number(stats.score(), 'f', 3) << "\n";
+        out << "  Ruined sessions: " << QString::number(stats.ruinFraction() * 100, 'f', 2) << "%\n";
+        out << "  Bankroll by round (5th / 50th / 95th percentile, % ruined):\n";
+        for (int checkpoint = 0; checkpoint < BankrollSimulator::CHECKPOINT_COUNT; ++checkpoint) {
+            out << QString("    %1  %2  %3  %4  %5%\n").arg(simulator.getCheckpointRound(checkpoint), 10)
+                       .arg(simulator.getBankrollPercentile(i, checkpoint, 5), 9, 'f', 1)
+                       .arg(simulator.getBankrollPercentile(i, checkpoint, 50), 9, 'f', 1)
+                       .arg(simulator.getBankrollPercentile(i, checkpoint, 95), 9, 'f', 1)
+                       .arg(simulator.getRuinFractionAt(i, checkpoint) * 100, 6, 'f', 2);
+        }
+    }
+    out << "\nElapsed: " << QString::number(seconds, 'f', 2) << " s ("
+        << QString::number(simulator.getRoundsPlayed() / qMax(seconds, 0.001), 'f', 0) << " rounds/s)\n";
+    return 0;
+}
+
+/// @brief Plays strategies against each other on common random numbers and reports each
+/// one's edge and how it differs from the first's.
+/// @return The exit code: 0 on success, 1 if a strategy is not known.
+int runTournament(const Ruleset& rules, const QStringList& names, qint64 rounds, int threads, quint64 seed,
+                  qint64 timeLimit, bool showProgress, QTextStream& out) {
+    QVector<StrategyTournament::Entrant> entrants;
+    for (const QString& name : names) {
+        HouseEdgeSimulator::StrategyFactory factory;
+        if (name == "basic") {
+            factory = HouseEdgeSimulator::createBasicStrategy;
+        } else if (name == "index") {
+            factory = [](const Ruleset& rules) -> std::unique_ptr<PlayerStrategy> {
+                return std::make_unique<IndexPlayer>(rules);
+            };
+        } else if (name == "composition") {
+            factory = [](const Ruleset& rules) -> std::unique_ptr<PlayerStrategy> {
+                return std::make_unique<CompositionPlayer>(rules);
+            };
+        } else {
+            out << "Unknown strategy " << name << " (expected basic, index, or composition)\n";
+            return 1;
+        }
+        entrants.append({ name, factory });
+    }
+    if (entrants.size() < 2) {
+        out << "A tournament needs at least two strategies\n";
+        return 1;
+    }
+
+    out << "Playing " << names.join(", ") << " on the same " << HouseEdgeSimulator::getShoeCount(rules, rounds)
+        << " shoes (about " << rounds << " rounds) on " << threads << " threads (seed " << seed << ")...\n";
+    out.flush();
+
+    QElapsedTimer timer;
+    timer.start();
+    StrategyTournament tournament(rules, entrants);
+    TournamentStats stats;
+    runWithProgress(tournament, [&]() {
+        stats = tournament.run(rounds, threads, seed);
+    }, timer, timeLimit, showProgress);
+    double seconds = timer.elapsed() / 1000.0;
+    if (tournament.isCancelled())
+        out << "Stopped at the time limit after " << stats.rounds << " rounds.\n";
+
+    out << "Rounds:       " << stats.rounds << "\n";
+    out << "Player edge:\n";
+    for (int i = 0; i < entrants.size(); ++i)
+        out << QString("  %1  ").arg(entrants[i].name, -12) << formatPercent(stats.playerEdge(i), stats.playerEdgeMargin(i)) << "\n";
+    out << "Difference from " << entrants[0].name << " (paired; variance reduction over independent shoes):\n";
+    for (int i = 1; i < entrants.size(); ++i) {
+        out << QString("  %1  ").arg(entrants[i].name, -12)
+            << formatPercent(stats.edgeDifference(i, 0), stats.edgeDifferenceMargin(i, 0))
+            << QString("  (%1x)\n").arg(stats.varianceReduction(i, 0), 0, 'f', 1);
+    }
+    out << "Elapsed:      " << QString::number(seconds, 'f', 2) << " s ("
+        << QString::number(stats.rounds / qMax(seconds, 0.001), 'f', 0) << " rounds/s)\n";
+    return 0;
+}
+
+/// @brief Replays a session file, or every session file in a directory, and reports any
+/// session whose replay does not match.
+/// @return The exit code: 0 if every session matched, 1 otherwise.
+int replaySessions(const QString& path, int threads, QTextStream& out) {
+    QStringList paths;
+    QFileInfo info(path);
+    if (info.isDir()) {
+        QDir directory(path);
+        for (const QString& name : directory.entryList({ "*.bjlog" }, QDir::Files, QDir::Name))
+            paths.append(directory.filePath(name));
+    }
+    else {
+        paths.append(path);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QVector<SessionReplayer::Result> results = SessionReplayer::replayFiles(paths, threads);
+    qint64 rounds = 0;
+    int mismatches = 0;
+    for (int i = 0; i < results.size(); ++i) {
+        rounds += results[i].rounds;
+        if (!results[i].matches) {
+            out << "MISMATCH " << paths[i] << ": " << results[i].message << "\n";
+            mismatches++;
+        }
+    }
+    out << "Replayed " << paths.size() << " sessions (" << rounds << " rounds) in "
+        << QString::number(timer.elapsed() / 1000.0, 'f', 2) << " s; " << mismatches << " did not match.\n";
+    return mismatches == 0 ? 0 : 1;
+}
+
+/// @brief Summarizes a columnar decision file: how often each action was taken, and how
+/// often it was the recommended action.
+/// @return The exit code: 0 if the file was read, 1 otherwise.
+int summarizeDecisions(const QString& path, QTextStream& out) {
+    ColumnarDecisionReader reader;
+    if (!reader.open(path)) {
+        out << "Could not read decision file " << path << "\n";
+        return 1;
+    }
+
+    constexpr int ACTION_COUNT = static_cast<int>(BasicStrategyChecker::PlayerAction::Surrender) + 1;
+    qint64 taken[ACTION_COUNT] = {};
+    qint64 recommended[ACTION_COUNT] = {};
+    qint64 rows = 0;
+    DecisionColumns columns;
+    while (reader.readBlock(columns)) {
+        for (std::size_t i = 0; i < columns.size(); ++i) {
+            if (columns.actions[i] >= ACTION_COUNT)
+                continue;
+            taken[columns.actions[i]]++;
+            if (columns.actions[i] == columns.bestActions[i])
+                recommended[columns.actions[i]]++;
+        }
+        rows += static_cast<qint64>(columns.size());
+    }
+
+    out << rows << " decisions\n";
+    for (int action = 0; action < ACTION_COUNT; ++action) {
+        if (taken[action] == 0)
+            continue;
+        out << "  " << getActionName(static_cast<BasicStrategyChecker::PlayerAction>(action)) << ": "
+            << taken[action] << " (" << recommended[action] << " recommended)\n";
+    }
+    return 0;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("blackjack-simulator");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Estimates the house edge of a blackjack ruleset by Monte Carlo simulation.");
+    parser.addHelpOption();
+
+    QCommandLineOption roundsOption("rounds", "Number of rounds to simulate.", "count", "10000000");
+    QCommandLineOption threadsOption("threads", "Number of threads (default: all cores).", "count");
+    QCommandLineOption seedOption("seed", "Seed for the shoes (default: random).", "seed");
+    QCommandLineOption decksOption("decks", "Number of decks in the shoe.", "count", "6");
+    QCommandLineOption payoutOption("payout", "Blackjack payout (1.5 = 3:2, 1.2 = 6:5).", "ratio", "1.5");
+    QCommandLineOption s17Option("s17", "Dealer stands on soft 17.");
+    QCommandLineOption noPeekOption("no-peek", "Dealer does not peek for blackjack.");
+    QCommandLineOption push22Option("push-22", "Dealer 22 pushes (free bet style).");
+    QCommandLineOption noDasOption("no-das", "No doubling after splitting.");
+    QCommandLineOption noResplitOption("no-resplit", "No resplitting.");
+    QCommandLineOption hitSplitAcesOption("hit-split-aces", "Split aces may be hit.");
+    QCommandLineOption resplitAcesOption("resplit-aces", "Aces may be resplit.");
+    QCommandLineOption noSurrenderOption("no-surrender", "No late surrender.");
+    QCommandLineOption indexPlaysOption("index-plays", "Play the Illustrious 18 and Fab 4 Hi-Lo index plays.");
+    QCommandLineOption byCountOption("by-count", "Show the player's edge at each Hi-Lo true count.");
+    QCommandLineOption progressOption("progress", "Show progress while simulating.");
+    QCommandLineOption timeLimitOption("time-limit", "Stop after this many seconds.", "seconds");
+    QCommandLineOption replayOption("replay", "Replay a recorded session file, or every session in a directory, and check the results.", "path");
+    QCommandLineOption decisionsOption("decisions", "Summarize an exported decision file (.bjcx).", "path");
+    QCommandLineOption tournamentOption("tournament", "Compare strategies on the same shoes, as a comma-separated list of basic, index, and composition; the first is the baseline.", "strategies");
+    QCommandLineOption rampOption("ramp", "Simulate bankroll sessions betting by the true count, as min-max:start:step[:out:in][@system] units, where system is hilo, ko, hiopt2, omega2, zen, or halves (repeat to compare ramps).", "ramp");
+    QCommandLineOption sessionsOption("sessions", "Number of bankroll sessions (with --ramp).", "count", "1000");
+    QCommandLineOption sessionRoundsOption("session-rounds", "Rounds dealt in each bankroll session (with --ramp).", "count", "10000");
+    QCommandLineOption bankrollOption("bankroll", "Starting bankroll of each session, in units (with --ramp).", "units", "200");
+    QCommandLineOption ruinOption("ruin", "Estimate the risk of ruin within --session-rounds rounds by multilevel splitting (with --ramp).");
+    QCommandLineOption levelsOption("levels", "Number of bankroll levels for --ruin, counting ruin.", "count", "8");
+    QCommandLineOption trialsOption("trials", "Trajectories started at each level for --ruin.", "count", "200");
+    QCommandLineOption replicationsOption("replications", "Independent replications for --ruin.", "count", "32");
+    parser.addOptions({ roundsOption, threadsOption, seedOption, decksOption, payoutOption,
+                        s17Option, noPeekOption, push22Option, noDasOption, noResplitOption,
+                        hitSplitAcesOption, resplitAcesOption, noSurrenderOption, indexPlaysOption,
+                        byCountOption, progressOption, timeLimitOption, replayOption,
+                        decisionsOption, tournamentOption, rampOption, sessionsOption, sessionRoundsOption, bankrollOption,
+                        ruinOption, levelsOption, trialsOption, replicationsOption });
+    parser.process(app);
+
+    QTextStream out(stdout);
+    Ruleset rules;
+    qint64 rounds = 0;
+    qint64 sessions = 0;
+    qint64 sessionRounds = 0;
+    int bankrollUnits = 0;
+    int levelCount = 0;
+    int trialsPerLevel = 0;
+    int replications = 0;
+    if (!readCount(parser, decksOption, rules.numDecks, out) || !readCount(parser, roundsOption, rounds, out)
+        || !readCount(parser, sessionsOption, sessions, out) || !readCount(parser, sessionRoundsOption, sessionRounds, out)
+        || !readCount(parser, bankrollOption, bankrollUnits, out) || !readCount(parser, levelsOption, levelCount, out)
+        || !readCount(parser, trialsOption, trialsPerLevel, out)
+        || !readCount(parser, replicationsOption, replications, out))
+        return 1;
+    rules.blackjackPayout = parser.value(payoutOption).toDouble();
+    rules.dealerHitsSoft17 = !parser.isSet(s17Option);
+    rules.dealerPeeks = !parser.isSet(noPeekOption);
+    rules.pushOnDealer22 = parser.isSet(push22Option);
+    rules.doubleAfterSplit = !parser.isSet(noDasOption);
+    rules.resplit = !parser.isSet(noResplitOption);
+    rules.hitSplitAces = parser.isSet(hitSplitAcesOption);
+    rules.resplitAces = parser.isSet(resplitAcesOption);
+    rules.surrenderAllowed = !parser.isSet(noSurrenderOption);
+
+    int threads = parser.isSet(threadsOption) ? parser.value(threadsOption).toInt()
+                                              : static_cast<int>(std::thread::hardware_concurrency());
+    quint64 seed = parser.isSet(seedOption) ? parser.value(seedOption).toULongLong()
+                                            : QRandomGenerator::global()->generate64();
+
+    if (parser.isSet(replayOption))
+        return replaySessions(parser.value(replayOption), threads, out);
+    if (parser.isSet(decisionsOption))
+        return summarizeDecisions(parser.value(decisionsOption), out);
+
+    bool showProgress = parser.isSet(progressOption);
+    qint64 timeLimit = parser.isSet(timeLimitOption) ? parser.value(timeLimitOption).toLongLong() * 1000 : -1;
+    if (parser.isSet(tournamentOption)) {
+        return runTournament(rules, parser.value(tournamentOption).split(','), rounds, threads, seed, timeLimit,
+                             showProgress, out);
+    }
+
+    HouseEdgeSimulator::StrategyFactory strategyFactory;
+    if (parser.isSet(indexPlaysOption)) {
+        strategyFactory = [](const Ruleset& rules) -> std::unique_ptr<PlayerStrategy> {
+            return std::make_unique<IndexPlayer>(rules);
+        };
+    }
+    if (parser.isSet(rampOption) && parser.isSet(ruinOption)) {
+        return estimateRuin(rules, parser.values(rampOption), sessionRounds, bankrollUnits, levelCount,
+                            trialsPerLevel, replications, threads, seed, strategyFactory, timeLimit, showProgress,
+                            out);
+    }
+    if (parser.isSet(rampOption)) {
+        return simulateBankroll(rules, parser.values(rampOption), sessions, sessionRounds, bankrollUnits, threads,
+                                seed, strategyFactory, timeLimit, showProgress, out);
+    }
+
+    out << "Simulating " << HouseEdgeSimulator::getShoeCount(rules, rounds) << " shoes (about " << rounds
+        << " rounds) on " << threads << " threads (seed " << seed << ")...\n";
+    out.flush();
+
+    QElapsedTimer timer;
+    timer.start();
+    HouseEdgeSimulator simulator(rules, strategyFactory);
+    SimulationStats stats;
+    runWithProgress(simulator, [&]() {
+        stats = simulator.run(rounds, threads, seed);
+    }, timer, timeLimit, showProgress);
+    double seconds = timer.elapsed() / 1000.0;
+
+    if (simulator.isCancelled())
+        out << "Stopped at the time limit after " << stats.rounds << " rounds.\n";
+
+    out << "House edge:   " << formatPercent(stats.houseEdge(), stats.houseEdgeMargin()) << "\n";
+    out << "Variance:     " << QString::number(stats.variance(), 'f', 4) << " (per round, in initial bets)\n";
+    out << "Hands:        " << stats.hands << "\n";
+    out << "Wins:         " << formatPercent(stats.frequency(stats.wins), stats.frequencyMargin(stats.wins)) << "\n";
+    out << "Pushes:       " << formatPercent(stats.frequency(stats.pushes), stats.frequencyMargin(stats.pushes)) << "\n";
+    out << "Losses:       " << formatPercent(stats.frequency(stats.losses), stats.frequencyMargin(stats.losses)) << "\n";
+    out << "Blackjacks:   " << formatPercent(stats.frequency(stats.blackjacks), stats.frequencyMargin(stats.blackjacks)) << "\n";
+    out << "Surrenders:   " << formatPercent(stats.frequency(stats.surrenders), stats.frequencyMargin(stats.surrenders)) << "\n";
+    if (parser.isSet(byCountOption)) {
+        out << "By true count (rounds, player edge):\n";
+        for (int trueCount = -SimulationStats::MAX_BUCKET_COUNT; trueCount <= SimulationStats::MAX_BUCKET_COUNT; ++trueCount) {
+            const SimulationStats::CountBucket& bucket = stats.getTrueCountBucket(trueCount);
+            if (bucket.rounds == 0)
+                continue;
+            out << QString("  %1%2  %3  %4%\n").arg(trueCount == -SimulationStats::MAX_BUCKET_COUNT ? "<=" :
+                                                    trueCount == SimulationStats::MAX_BUCKET_COUNT ? ">=" : "  ")
+                                               .arg(trueCount, 3).arg(bucket.rounds, 12)
+                                               .arg(stats.playerEdgeAt(trueCount) * 100, 8, 'f', 3);
+        }
+    }
+    out << "Elapsed:      " << QString::number(seconds, 'f', 2) << " s ("
+        << QString::number(stats.rounds / qMax(seconds, 0.001), 'f', 0) << " rounds/s)\n";
+    return 0;
+}
@@ -0,0 +1,235 @@
+#include "strategy_solver.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include "composition.h"
+
+namespace {
+
+using PlayerAction = BasicStrategyChecker::PlayerAction;
+using MoveChain = BasicStrategyChecker::MoveChain;
+using MoveTable = BasicStrategyChecker::MoveTable;
+
+/// @brief Marks a cache file as holding a strategy table ("BJST").
+constexpr quint32 FILE_MAGIC = 0x424A5354;
+
+/// @brief The number of cells in a table.
+constexpr int CELL_COUNT = BasicStrategyChecker::HAND_KEY_COUNT * 10;
+
+/// @brief Gets a card with the given value index (see Composition::indexOf).
+Card cardFor(int index) {
+    return Card(static_cast<Card::Rank>(static_cast<int>(Card::Rank::Ace) + index), Card::Suit::Spades);
+}
+
+/// @brief Gets the value indices of the two-card hands that make a total. Pairs are only
+/// used when no other hand makes the total (hard 4, hard 20, and soft 12).
+std::vector<std::pair<int, int>> handsForTotal(int total, bool isSoft) {
+    std::vector<std::pair<int, int>> hands;
+    for (int first = 0; first < Composition::VALUE_COUNT; ++first) {
+        for (int second = first + 1; second < Composition::VALUE_COUNT; ++second) {
+            bool hasAce = first == 0;
+            int value = Composition::valueOf(first) + Composition::valueOf(second) + (hasAce ? 10 : 0);
+            if (hasAce == isSoft && value == total)
+                hands.emplace_back(first, second);
+        }
+    }
+
+    if (hands.empty()) {
+        int index = isSoft ? 0 : total / 2 - 1;
+        hands.emplace_back(index, index);
+    }
+    return hands;
+}
+
+}
+
+StrategySolver::StrategySolver(const Ruleset& rules) :
+    rules_(rules)
+{}
+
+BasicStrategyChecker::MoveTable StrategySolver::solve(int threads) const {
+    threads = qBound(1, threads, CELL_COUNT);
+
+    // Each thread takes the next unsolved cell until there are none left. Every cell is
+    // written by exactly one thread.
+    MoveTable table {};
+    std::atomic<int> nextCell(0);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back([this, &table, &nextCell]() {
+            ExpectedValueCalculator calculator(rules_);
+            for (int cell = nextCell++; cell < CELL_COUNT; cell = nextCell++)
+                table[cell / 10][cell % 10] = solveCell(calculator, cell / 10, cell % 10);
+        });
+    }
+    for (std::thread& worker : workers)
+        worker.join();
+    return table;
+}
+
+BasicStrategyChecker::MoveChain StrategySolver::solveCell(const ExpectedValueCalculator& calculator, int handKey,
+                                                          int upcardColumn) const {
+    std::vector<std::pair<int, int>> hands;
+    bool isPairRow = handKey >= BasicStrategyChecker::SPLITTING_KEY;
+    if (isPairRow) {
+        int pairValue = handKey - BasicStrategyChecker::SPLITTING_KEY + 2;
+        int index = pairValue == 11 ? 0 : pairValue - 1;
+        hands.emplace_back(index, index);
+    }
+    else {
+        bool isSoft = handKey >= BasicStrategyChecker::SOFT_TOTALS_KEY;
+        int total = isSoft ? handKey - BasicStrategyChecker::SOFT_TOTALS_KEY + 12
+                           : handKey - BasicStrategyChecker::HARD_TOTALS_KEY + 4;
+        if (total == 21)
+            return MoveChain { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand };
+        hands = handsForTotal(total, isSoft);
+    }
+
+    Composition shoe;
+    for (int i = 0; i < Composition::VALUE_COUNT; ++i)
+        shoe.setCount(i, (i == Composition::VALUE_COUNT - 1 ? 16 : 4) * rules_.numDecks);
+    int upcardIndex = upcardColumn == 9 ? 0 : upcardColumn + 1;
+    Card upcard = cardFor(upcardIndex);
+    shoe.remove(upcardIndex);
+
+    // Average each action's expected value over the hands, weighted by how likely each
+    // hand is to be dealt
+    const PlayerAction actions[] { PlayerAction::Stand, PlayerAction::Hit, PlayerAction::Double,
+                                   PlayerAction::Split, PlayerAction::Surrender };
+    double sums[5] {};
+    double totalWeight = 0;
+    for (const auto& cards : hands) {
+        double weight = static_cast<double>(shoe.counts[cards.first])
+                        * (shoe.counts[cards.second] - (cards.first == cards.second ? 1 : 0))
+                        * (cards.first == cards.second ? 1 : 2);
+        if (weight <= 0) continue;
+
+        Composition unseen = shoe;
+        unseen.remove(cards.first);
+        unseen.remove(cards.second);
+        Hand hand;
+        hand.addCard(cardFor(cards.first));
+        hand.addCard(cardFor(cards.second));
+
+        ExpectedValueCalculator::ActionValues values = calculator.evaluate(hand, upcard, unseen);
+        for (int i = 0; i < 5; ++i)
+            sums[i] += weight * values.valueOf(actions[i]);
+        totalWeight += weight;
+    }
+
+    // Rank the actions that can be taken; splitting only counts in the pair rows
+    std::vector<std::pair<double, PlayerAction>> ranked;
+    for (int i = 0; i < 5; ++i) {
+        if (std::isnan(sums[i]) || totalWeight <= 0) continue;
+        if (actions[i] == PlayerAction::Split && !isPairRow) continue;
+        ranked.emplace_back(sums[i] / totalWeight, actions[i]);
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first;
+    });
+
+    // Follow the ranking until it reaches a move that can always be made
+    PlayerAction chain[3] { PlayerAction::Stand, PlayerAction::Stand, PlayerAction::Stand };
+    int length = 0;
+    for (const auto& entry : ranked) {
+        chain[length++] = entry.second;
+        if (length == 3 || entry.second == PlayerAction::Hit || entry.second == PlayerAction::Stand)
+            break;
+    }
+    for (int i = qMax(length, 1); i < 3; ++i)
+        chain[i] = chain[i - 1];
+    return MoveChain { chain[0], chain[1], chain[2] };
+}
+
+quint64 StrategySolver::hashRules(const Ruleset& rules) {
+    // FNV-1a over the rules that affect the player's decisions
+    quint64 hash = 0xCBF29CE484222325ull;
+    auto mix = [&hash](quint64 value) {
+        hash = (hash ^ value) * 0x100000001B3ull;
+    };
+    mix(FILE_VERSION);
+    mix(static_cast<quint64>(rules.numDecks));
+    mix(rules.dealerHitsSoft17);
+    mix(rules.dealerPeeks);
+    mix(rules.pushOnDealer22);
+    mix(rules.doubleAfterSplit);
+    mix(rules.resplit);
+    mix(rules.hitSplitAces);
+    mix(rules.resplitAces);
+    mix(rules.surrenderAllowed);
+    return hash;
+}
+
+std::shared_ptr<const BasicStrategyChecker::MoveTable> StrategySolver::loadOrSolve(const Ruleset& rules,
+                                                                                   QString cacheDirectory) {
+    if (cacheDirectory.isEmpty())
+        cacheDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    quint64 rulesHash = hashRules(rules);
+    QString path = QDir(cacheDirectory).filePath(QString("strategy-%1.bin").arg(rulesHash, 16, 16, QChar('0')));
+
+    auto table = std::make_shared<MoveTable>();
+    if (load(path, rulesHash, *table))
+        return table;
+
+    *table = StrategySolver(rules).solve(static_cast<int>(std::thread::hardware_concurrency()));
+    QDir().mkpath(cacheDirectory);
+    save(path, rulesHash, *table);
+    return table;
+}
+
+bool StrategySolver::load(const QString& path, quint64 rulesHash, BasicStrategyChecker::MoveTable& table) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    quint32 magic;
+    quint16 version;
+    quint64 fileHash;
+    in >> magic >> version >> fileHash;
+    if (in.status() != QDataStream::Ok || magic != FILE_MAGIC || version != FILE_VERSION || fileHash != rulesHash)
+        return false;
+
+    MoveTable loaded;
+    for (auto& row : loaded) {
+        for (MoveChain& moves : row) {
+            for (PlayerAction* move : { &moves.best, &moves.second, &moves.third }) {
+                quint8 value;
+                in >> value;
+                if (value > static_cast<quint8>(PlayerAction::Surrender))
+                    return false;
+                *move = static_cast<PlayerAction>(value);
+            }
+        }
+    }
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    table = loaded;
+    return true;
+}
+
+bool StrategySolver::save(const QString& path, quint64 rulesHash, const BasicStrategyChecker::MoveTable& table) {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out << FILE_MAGIC << FILE_VERSION << rulesHash;
+    for (const auto& row : table) {
+        for (const MoveChain& moves : row) {
+            out << static_cast<quint8>(moves.best) << static_cast<quint8>(moves.second)
+                << static_cast<quint8>(moves.third);
+        }
+    }
+    return out.status() == QDataStream::Ok && file.commit();
+}
@@ -0,0 +1,79 @@
+#ifndef STRATEGY_SOLVER_H
+#define STRATEGY_SOLVER_H
+
+#include <memory>
+#include <QString>
+#include <QtGlobal>
+#include "basic_strategy_checker.h"
+#include "expected_value_calculator.h"
+#include "ruleset.h"
+
+/// @brief Derives the total-dependent basic strategy for any Ruleset, for the rules the
+/// compile-time tables in strategy_tables.h do not model (peeking, resplitting, hitting
+/// split aces, pushing on 22, or any deck count).
+///
+/// Each cell of the table (a hand key against an upcard) is solved with an
+/// ExpectedValueCalculator from a full shoe. The expected value of each action is
+/// averaged over every two-card hand that makes the cell's total, weighted by how likely
+/// it is to be dealt, and the actions are ranked into the cell's MoveChain. Cells are
+/// shared among worker threads, each with its own calculator.
+///
+/// Solved tables are cached in a small binary file named after a hash of the rules, so
+/// each ruleset is only solved once.
+class StrategySolver {
+public:
+    /// @brief The version of the cache file format. Changing how tables are solved should
+    /// also change this, so stale files are ignored.
+    static constexpr quint16 FILE_VERSION = 1;
+
+    /// @brief Creates a new StrategySolver.
+    /// @param rules The rules to solve for.
+    explicit StrategySolver(const Ruleset& rules);
+
+    /// @brief Solves every cell of the strategy table.
+    /// @param threads The number of threads to solve on (at least 1).
+    /// @return The solved table.
+    BasicStrategyChecker::MoveTable solve(int threads) const;
+
+    /// @brief Gets a hash of the rules that affect basic strategy. The blackjack payout
+    /// is left out, since it is settled before the player acts.
+    /// @param rules The rules to hash.
+    static quint64 hashRules(const Ruleset& rules);
+
+    /// @brief Gets the solved table for a ruleset, from the cache if it has been solved
+    /// before, or by solving it (on every core) and saving it to the cache otherwise.
+    /// @param rules The rules to solve for.
+    /// @param cacheDirectory The directory of the cache files. If empty, the application's
+    /// cache location is used.
+    /// @return The table.
+    static std::shared_ptr<const BasicStrategyChecker::MoveTable> loadOrSolve(const Ruleset& rules,
+                                                                             QString cacheDirectory = QString());
+
+    /// @brief Reads a table from a cache file.
+    /// @param path The path of the file.
+    /// @param rulesHash The hash of the rules the table must have been solved for.
+    /// @param table Receives the table.
+    /// @return True if the file exists and holds a table for the rules.
+    static bool load(const QString& path, quint64 rulesHash, BasicStrategyChecker::MoveTable& table);
+
+    /// @brief Writes a table to a cache file, replacing it atomically.
+    /// @param path The path of the file.
+    /// @param rulesHash The hash of the rules the table was solved for.
+    /// @param table The table.
+    /// @return True if the file was written.
+    static bool save(const QString& path, quint64 rulesHash, const BasicStrategyChecker::MoveTable& table);
+
+private:
+    /// @brief Solves one cell of the table.
+    /// @param calculator The calling thread's calculator.
+    /// @param handKey The hand key (row) of the cell.
+    /// @param upcardColumn The column of the dealer's upcard (2-10, then ace).
+    /// @return The moves for the cell.
+    BasicStrategyChecker::MoveChain solveCell(const ExpectedValueCalculator& calculator, int handKey,
+                                              int upcardColumn) const;
+
+    /// @brief The rules to solve for.
+    Ruleset rules_;
+};
+
+#endif // STRATEGY_SOLVER_H
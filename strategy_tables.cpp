@@ -0,0 +1,52 @@
+#include "strategy_tables.h"
+
+template struct StrategyTable<ShoeH17Rules>;
+template struct StrategyTable<ShoeS17Rules>;
+template struct StrategyTable<DoubleDeckH17Rules>;
+template struct StrategyTable<SingleDeckH17Rules>;
+
+namespace {
+
+using PlayerAction = BasicStrategyChecker::PlayerAction;
+
+// Spot checks of the generated tables against the published charts
+static_assert(StrategyTable<ShoeH17Rules>::MOVES[BasicStrategyChecker::SPLITTING_KEY + 6][9].best
+              == PlayerAction::Surrender, "H17 surrenders [8, 8] against an ace");
+static_assert(StrategyTable<ShoeS17Rules>::MOVES[BasicStrategyChecker::SPLITTING_KEY + 6][9].best
+              == PlayerAction::Split, "S17 splits [8, 8] against an ace");
+static_assert(StrategyTable<ShoeH17Rules>::MOVES[BasicStrategyChecker::SPLITTING_KEY + 8][4].best
+              == PlayerAction::Stand, "[10, 10] stands against a 6");
+static_assert(StrategyTable<ShoeS17Rules>::MOVES[BasicStrategyChecker::HARD_TOTALS_KEY + 7][9].best
+              == PlayerAction::Hit, "S17 hits 11 against an ace");
+
+/// @brief Gets the table for the given rules, choosing the deck count at run time.
+template <bool DealerHitsSoft17, bool DoubleAfterSplit, bool SurrenderAllowed>
+const BasicStrategyChecker::MoveTable& tableForDecks(int numDecks) {
+    if (numDecks <= 1)
+        return StrategyTable<StrategyRules<DealerHitsSoft17, DoubleAfterSplit, SurrenderAllowed, 1>>::MOVES;
+    if (numDecks == 2)
+        return StrategyTable<StrategyRules<DealerHitsSoft17, DoubleAfterSplit, SurrenderAllowed, 2>>::MOVES;
+    return StrategyTable<StrategyRules<DealerHitsSoft17, DoubleAfterSplit, SurrenderAllowed, 6>>::MOVES;
+}
+
+/// @brief Gets the table for the given rules, choosing surrender and the deck count at
+/// run time.
+template <bool DealerHitsSoft17, bool DoubleAfterSplit>
+const BasicStrategyChecker::MoveTable& tableForSurrender(const Ruleset& rules) {
+    return rules.surrenderAllowed ? tableForDecks<DealerHitsSoft17, DoubleAfterSplit, true>(rules.numDecks)
+                                  : tableForDecks<DealerHitsSoft17, DoubleAfterSplit, false>(rules.numDecks);
+}
+
+/// @brief Gets the table for the given rules, choosing DAS, surrender, and the deck count
+/// at run time.
+template <bool DealerHitsSoft17>
+const BasicStrategyChecker::MoveTable& tableForDoubleAfterSplit(const Ruleset& rules) {
+    return rules.doubleAfterSplit ? tableForSurrender<DealerHitsSoft17, true>(rules)
+                                  : tableForSurrender<DealerHitsSoft17, false>(rules);
+}
+
+}
+
+const BasicStrategyChecker::MoveTable& getStrategyTable(const Ruleset& rules) {
+    return rules.dealerHitsSoft17 ? tableForDoubleAfterSplit<true>(rules) : tableForDoubleAfterSplit<false>(rules);
+}
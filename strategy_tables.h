@@ -0,0 +1,188 @@
+#ifndef STRATEGY_TABLES_H
+#define STRATEGY_TABLES_H
+
+#include "basic_strategy_checker.h"
+#include "ruleset.h"
+
+/// @brief A compile-time rules policy for generating a basic strategy table. The policy
+/// holds the rules that change basic strategy, and decides each play from them; the
+/// decisions follow the standard total-dependent charts, with the well-known changes for
+/// H17, no DAS, and one- and two-deck games.
+/// @tparam DealerHitsSoft17 True if the dealer hits soft 17.
+/// @tparam DoubleAfterSplit True if split hands may be doubled.
+/// @tparam SurrenderAllowed True if late surrender is allowed.
+/// @tparam DeckCount The number of decks. Any number above two plays the same as six.
+template <bool DealerHitsSoft17, bool DoubleAfterSplit, bool SurrenderAllowed, int DeckCount>
+struct StrategyRules {
+    static constexpr bool dealerHitsSoft17 = DealerHitsSoft17;
+    static constexpr bool doubleAfterSplit = DoubleAfterSplit;
+    static constexpr bool surrenderAllowed = SurrenderAllowed;
+    static constexpr int deckCount = DeckCount;
+
+    // Every upcard below is the dealer's upcard value, from 2 to 11 (ace).
+
+    /// @brief Returns true if a hard total should be doubled.
+    static constexpr bool shouldDoubleHard(int total, int upcard) {
+        switch (total) {
+        case 8:
+            return deckCount == 1 && (upcard == 5 || upcard == 6);
+        case 9:
+            return (upcard >= 3 && upcard <= 6) || (deckCount <= 2 && upcard == 2);
+        case 10:
+            return upcard <= 9;
+        case 11:
+            return upcard <= 10 || dealerHitsSoft17 || deckCount <= 2;
+        default:
+            return false;
+        }
+    }
+
+    /// @brief Returns true if a soft total should be doubled.
+    static constexpr bool shouldDoubleSoft(int total, int upcard) {
+        switch (total) {
+        case 12:
+        case 13:
+        case 14:
+            return upcard == 5 || upcard == 6;
+        case 15:
+        case 16:
+            return upcard >= 4 && upcard <= 6;
+        case 17:
+            return (upcard >= 3 && upcard <= 6) || (deckCount == 1 && upcard == 2);
+        case 18:
+            return (upcard >= 3 && upcard <= 6) || (dealerHitsSoft17 && upcard == 2);
+        case 19:
+            return upcard == 6 && (dealerHitsSoft17 || deckCount == 1);
+        default:
+            return false;
+        }
+    }
+
+    /// @brief Returns true if a total should stand when it is not doubled or surrendered.
+    static constexpr bool shouldStand(int total, bool isSoft, int upcard) {
+        if (isSoft)
+            return total >= 19 || (total == 18 && upcard <= 8);
+        if (total >= 17)
+            return true;
+        if (total >= 13)
+            return upcard <= 6;
+        return total == 12 && upcard >= 4 && upcard <= 6;
+    }
+
+    /// @brief Returns true if a hard total should be surrendered.
+    static constexpr bool shouldSurrender(int total, int upcard) {
+        if (!surrenderAllowed)
+            return false;
+        if (total == 16)
+            return upcard >= 9;
+        if (total == 15)
+            return upcard == 10 || (dealerHitsSoft17 && upcard == 11);
+        return total == 17 && dealerHitsSoft17 && upcard == 11;
+    }
+
+    /// @brief Returns true if a pair should be split.
+    /// @param pairValue The value of each card in the pair, from 2 to 11 (aces).
+    static constexpr bool shouldSplit(int pairValue, int upcard) {
+        switch (pairValue) {
+        case 2:
+        case 3:
+            return upcard <= 7 && (doubleAfterSplit || upcard >= 4);
+        case 4:
+            return doubleAfterSplit && (upcard == 5 || upcard == 6);
+        case 6:
+            return upcard <= 6 && (doubleAfterSplit || upcard >= 3);
+        case 7:
+            return upcard <= 7;
+        case 8:
+        case 11:
+            return true;
+        case 9:
+            return upcard <= 9 && upcard != 7;
+        default:
+            // Fives play as a hard 10, and tens as a hard 20
+            return false;
+        }
+    }
+
+    /// @brief Returns true if a pair should be surrendered rather than split.
+    static constexpr bool shouldSurrenderPair(int pairValue, int upcard) {
+        return surrenderAllowed && dealerHitsSoft17 && pairValue == 8 && upcard == 11;
+    }
+};
+
+/// @brief Six or eight decks, H17, DAS, and late surrender (the default Ruleset).
+using ShoeH17Rules = StrategyRules<true, true, true, 6>;
+
+/// @brief Six or eight decks, S17, DAS, and late surrender.
+using ShoeS17Rules = StrategyRules<false, true, true, 6>;
+
+/// @brief Two decks, H17, DAS, and no surrender.
+using DoubleDeckH17Rules = StrategyRules<true, true, false, 2>;
+
+/// @brief One deck, H17, no DAS, and no surrender.
+using SingleDeckH17Rules = StrategyRules<true, false, false, 1>;
+
+/// @brief The strategy table generated from a rules policy. MOVES is computed entirely at
+/// compile time, so looking up a play never branches on the rules.
+/// @tparam Rules A rules policy, such as a StrategyRules.
+template <typename Rules>
+struct StrategyTable {
+    using PlayerAction = BasicStrategyChecker::PlayerAction;
+    using MoveChain = BasicStrategyChecker::MoveChain;
+    using MoveTable = BasicStrategyChecker::MoveTable;
+
+    /// @brief Gets the moves for a hard or soft total. A double or surrender falls back to
+    /// hitting or standing.
+    static constexpr MoveChain totalsChain(int total, bool isSoft, int upcard) {
+        PlayerAction fallback = Rules::shouldStand(total, isSoft, upcard) ? PlayerAction::Stand
+                                                                          : PlayerAction::Hit;
+        PlayerAction best = fallback;
+        if (!isSoft && Rules::shouldSurrender(total, upcard))
+            best = PlayerAction::Surrender;
+        else if (isSoft ? Rules::shouldDoubleSoft(total, upcard) : Rules::shouldDoubleHard(total, upcard))
+            best = PlayerAction::Double;
+        return MoveChain { best, fallback, fallback };
+    }
+
+    /// @brief Gets the moves for a pair. A split falls back to the pair's total.
+    static constexpr MoveChain pairChain(int pairValue, int upcard) {
+        bool isAces = pairValue == 11;
+        MoveChain totals = totalsChain(isAces ? 12 : 2 * pairValue, isAces, upcard);
+        if (Rules::shouldSurrenderPair(pairValue, upcard))
+            return MoveChain { PlayerAction::Surrender, PlayerAction::Split, totals.third };
+        if (Rules::shouldSplit(pairValue, upcard))
+            return MoveChain { PlayerAction::Split, totals.best, totals.second };
+        return totals;
+    }
+
+    /// @brief Generates the table for every hand key and upcard.
+    static constexpr MoveTable generate() {
+        MoveTable table {};
+        for (int column = 0; column < 10; ++column) {
+            int upcard = column + 2;
+            for (int total = 4; total <= 21; ++total)
+                table[BasicStrategyChecker::HARD_TOTALS_KEY + total - 4][column] = totalsChain(total, false, upcard);
+            for (int total = 12; total <= 21; ++total)
+                table[BasicStrategyChecker::SOFT_TOTALS_KEY + total - 12][column] = totalsChain(total, true, upcard);
+            for (int pairValue = 2; pairValue <= 11; ++pairValue)
+                table[BasicStrategyChecker::SPLITTING_KEY + pairValue - 2][column] = pairChain(pairValue, upcard);
+        }
+        return table;
+    }
+
+    /// @brief The moves for every hand key and upcard.
+    static constexpr MoveTable MOVES = generate();
+};
+
+extern template struct StrategyTable<ShoeH17Rules>;
+extern template struct StrategyTable<ShoeS17Rules>;
+extern template struct StrategyTable<DoubleDeckH17Rules>;
+extern template struct StrategyTable<SingleDeckH17Rules>;
+
+/// @brief Gets the generated strategy table that matches a ruleset.
+/// @param rules The rules of the game. Only dealerHitsSoft17, doubleAfterSplit,
+/// surrenderAllowed, and numDecks affect the table chosen.
+/// @return The table, which lives for the whole program.
+const BasicStrategyChecker::MoveTable& getStrategyTable(const Ruleset& rules);
+
+#endif // STRATEGY_TABLES_H
@@ -0,0 +1,154 @@
+#include "strategy_tournament.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+
+/// @brief The square of the size of an initial bet, to convert squared chips to squared
+/// initial bets.
+constexpr double BET_UNIT_SQUARED = static_cast<double>(HouseEdgeSimulator::BET_UNIT) * HouseEdgeSimulator::BET_UNIT;
+
+}
+
+// Totals
+
+TournamentStats::TournamentStats(int entrantCount) :
+    entrantCount(entrantCount), netWinnings(entrantCount), netWinningsSquared(entrantCount),
+    differencesSquared(static_cast<std::size_t>(entrantCount) * entrantCount)
+{}
+
+void TournamentStats::merge(const TournamentStats& other) {
+    rounds += other.rounds;
+    for (int i = 0; i < entrantCount; ++i) {
+        netWinnings[i] += other.netWinnings[i];
+        netWinningsSquared[i] += other.netWinningsSquared[i];
+    }
+    for (std::size_t i = 0; i < differencesSquared.size(); ++i)
+        differencesSquared[i] += other.differencesSquared[i];
+}
+
+double TournamentStats::playerEdge(int entrant) const {
+    if (rounds == 0) return 0;
+    return static_cast<double>(netWinnings[entrant]) / (static_cast<double>(rounds) * HouseEdgeSimulator::BET_UNIT);
+}
+
+double TournamentStats::variance(int entrant) const {
+    if (rounds < 2) return 0;
+    double n = static_cast<double>(rounds);
+    double mean = netWinnings[entrant] / n;
+    return (netWinningsSquared[entrant] - n * mean * mean) / (n - 1) / BET_UNIT_SQUARED;
+}
+
+double TournamentStats::playerEdgeMargin(int entrant) const {
+    if (rounds == 0) return 0;
+    return HouseEdgeSimulator::Z_95 * std::sqrt(variance(entrant) / rounds);
+}
+
+double TournamentStats::edgeDifference(int entrant, int other) const {
+    return playerEdge(entrant) - playerEdge(other);
+}
+
+double TournamentStats::differenceVariance(int entrant, int other) const {
+    if (rounds < 2) return 0;
+    double n = static_cast<double>(rounds);
+    double mean = static_cast<double>(netWinnings[entrant] - netWinnings[other]) / n;
+    double squares = static_cast<double>(differencesSquared[static_cast<std::size_t>(entrant) * entrantCount + other]);
+    return qMax(0.0, (squares - n * mean * mean) / (n - 1) / BET_UNIT_SQUARED);
+}
+
+double TournamentStats::edgeDifferenceMargin(int entrant, int other) const {
+    if (rounds == 0) return 0;
+    return HouseEdgeSimulator::Z_95 * std::sqrt(differenceVariance(entrant, other) / rounds);
+}
+
+double TournamentStats::varianceReduction(int entrant, int other) const {
+    double paired = differenceVariance(entrant, other);
+    if (paired <= 0) return std::numeric_limits<double>::infinity();
+    return (variance(entrant) + variance(other)) / paired;
+}
+
+// Tournament
+
+StrategyTournament::Worker::Worker(const Ruleset& rules, const QVector<Entrant>& entrants) :
+    reference(rules, HouseEdgeSimulator::SIMULATION_BALANCE), challenger(rules, HouseEdgeSimulator::SIMULATION_BALANCE),
+    nets(entrants.size()), stats(entrants.size()) {
+    for (const Entrant& entrant : entrants)
+        strategies.push_back(entrant.factory(rules));
+}
+
+StrategyTournament::StrategyTournament(const Ruleset& rules, const QVector<Entrant>& entrants) :
+    rules_(rules), entrants_(entrants), roundsPlayed_(0)
+{}
+
+TournamentStats StrategyTournament::run(qint64 rounds, int threads, quint64 seed) {
+    qint64 shoes = HouseEdgeSimulator::getShoeCount(rules_, rounds);
+    threads = static_cast<int>(qBound<qint64>(1, threads, shoes));
+
+    std::vector<Worker> workers;
+    workers.reserve(threads);
+    for (int i = 0; i < threads; ++i)
+        workers.emplace_back(rules_, entrants_);
+
+    roundsPlayed_ = 0;
+    scheduler_.run(shoes, threads, [this, &workers, seed](int worker, qint64 shoe) {
+        qint64 played = runShoe(workers[worker], seed, shoe);
+        roundsPlayed_.fetch_add(played, std::memory_order_relaxed);
+    });
+
+    TournamentStats total(entrants_.size());
+    for (const Worker& worker : workers)
+        total.merge(worker.stats);
+    return total;
+}
+
+void StrategyTournament::cancel() {
+    scheduler_.cancel();
+}
+
+bool StrategyTournament::isCancelled() const {
+    return scheduler_.isCancelled();
+}
+
+double StrategyTournament::getProgress() const {
+    qint64 shoes = scheduler_.getTaskCount();
+    if (shoes == 0) return 0;
+    return static_cast<double>(scheduler_.getCompletedTasks()) / shoes;
+}
+
+qint64 StrategyTournament::getRoundsPlayed() const {
+    return roundsPlayed_.load(std::memory_order_relaxed);
+}
+
+qint64 StrategyTournament::runShoe(Worker& worker, quint64 seed, qint64 shoe) const {
+    int entrantCount = entrants_.size();
+    TournamentStats& stats = worker.stats;
+    worker.reference.seedShoe(seed, static_cast<quint64>(shoe));
+
+    qint64 rounds = 0;
+    do {
+        // The challengers play first, each on a copy of the engine as it stands before
+        // the round, and the reference last, advancing the shoe for the next round
+        for (int i = entrantCount - 1; i >= 0; --i) {
+            RoundEngine& engine = i == 0 ? worker.reference : worker.challenger;
+            if (i != 0)
+                engine = worker.reference;
+            PlayerStrategy& strategy = *worker.strategies[i];
+            engine.setBalance(HouseEdgeSimulator::SIMULATION_BALANCE);
+            worker.nets[i] = engine.playRound(HouseEdgeSimulator::BET_UNIT, [&strategy](const RoundEngine& engine) {
+                return strategy.chooseAction(engine);
+            });
+        }
+
+        rounds++;
+        stats.rounds++;
+        for (int i = 0; i < entrantCount; ++i) {
+            stats.netWinnings[i] += worker.nets[i];
+            stats.netWinningsSquared[i] += worker.nets[i] * worker.nets[i];
+            for (int j = 0; j < entrantCount; ++j) {
+                qint64 difference = worker.nets[i] - worker.nets[j];
+                stats.differencesSquared[static_cast<std::size_t>(i) * entrantCount + j] += difference * difference;
+            }
+        }
+    } while (!worker.reference.getNeedsShuffling() && !scheduler_.isCancelled());
+    return rounds;
+}
@@ -0,0 +1,162 @@
+#ifndef STRATEGY_TOURNAMENT_H
+#define STRATEGY_TOURNAMENT_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include "house_edge_simulator.h"
+#include "player_strategy.h"
+#include "round_engine.h"
+#include "ruleset.h"
+#include "work_stealing_scheduler.h"
+
+/// @brief Totals from a StrategyTournament: each entrant's net winnings, and the squared
+/// difference of every pair of entrants' winnings, round by round. Net winnings are in
+/// chips, where one initial bet is HouseEdgeSimulator::BET_UNIT chips. Every field is a
+/// plain sum, so totals can be combined with merge.
+struct TournamentStats {
+    /// @brief Creates empty totals for a number of entrants.
+    explicit TournamentStats(int entrantCount = 0);
+
+    /// @brief The number of entrants.
+    int entrantCount;
+
+    /// @brief The number of rounds every entrant played.
+    qint64 rounds = 0;
+
+    /// @brief The sum of each entrant's net winnings.
+    std::vector<qint64> netWinnings;
+
+    /// @brief The sum of the squares of each entrant's net winnings for each round.
+    std::vector<qint64> netWinningsSquared;
+
+    /// @brief The sum over rounds of the squared difference between two entrants' net
+    /// winnings, indexed by first * entrantCount + second.
+    std::vector<qint64> differencesSquared;
+
+    /// @brief Adds another set of totals into this one.
+    void merge(const TournamentStats& other);
+
+    /// @brief Gets an entrant's expected result per round, as a fraction of the initial
+    /// bet (the negative of the house edge).
+    double playerEdge(int entrant) const;
+
+    /// @brief Gets the half-width of the 95% confidence interval around an entrant's edge.
+    double playerEdgeMargin(int entrant) const;
+
+    /// @brief Gets how much more one entrant wins per round than another, as a fraction of
+    /// the initial bet.
+    double edgeDifference(int entrant, int other) const;
+
+    /// @brief Gets the half-width of the 95% confidence interval around edgeDifference,
+    /// from the paired per-round differences.
+    double edgeDifferenceMargin(int entrant, int other) const;
+
+    /// @brief Gets how many times more rounds two independent simulations would need to
+    /// measure the difference between two entrants as precisely: the variance of the
+    /// difference of independent results over the variance of the paired differences.
+    double varianceReduction(int entrant, int other) const;
+
+private:
+    /// @brief Gets the variance of an entrant's net result per round, in initial bets
+    /// squared.
+    double variance(int entrant) const;
+
+    /// @brief Gets the variance of the paired difference per round, in initial bets
+    /// squared.
+    double differenceVariance(int entrant, int other) const;
+};
+
+/// @brief Compares playing strategies on common random numbers: every entrant plays every
+/// round from exactly the same shoe state, so they are dealt the same cards until their
+/// decisions differ, and their results are paired round by round. Differences in edge of
+/// a few hundredths of a percent, which independent simulations need enormous runs to
+/// resolve, are measured from the much smaller variance of the paired differences.
+///
+/// The first entrant is the reference: between rounds the shoe advances as the
+/// reference played it, and each other entrant plays the round on a copy of the
+/// reference's engine. Every entrant is therefore measured on the same sequence of shoe
+/// states, the ones the reference reaches.
+///
+/// Each task plays one shoe, seeded from the seed and the shoe's index, on a
+/// WorkStealingScheduler, so results are the same for any number of threads.
+class StrategyTournament {
+public:
+    /// @brief A strategy taking part in the tournament.
+    struct Entrant {
+        /// @brief The name shown in reports.
+        QString name;
+
+        /// @brief Creates the strategy for each thread.
+        HouseEdgeSimulator::StrategyFactory factory;
+    };
+
+    /// @brief Creates a new StrategyTournament.
+    /// @param rules The rules to play under.
+    /// @param entrants The strategies to compare; the first is the reference.
+    StrategyTournament(const Ruleset& rules, const QVector<Entrant>& entrants);
+
+    /// @brief Plays whole shoes until about the given number of rounds have been played
+    /// (see HouseEdgeSimulator::getShoeCount).
+    /// @param rounds The number of rounds to play.
+    /// @param threads The number of threads to play on (at least 1).
+    /// @param seed The seed for the shoes.
+    /// @return The merged totals of every round played.
+    TournamentStats run(qint64 rounds, int threads, quint64 seed);
+
+    /// @brief Stops the current run after the rounds in progress. May be called from any
+    /// thread.
+    void cancel();
+
+    /// @brief Returns true if the current (or last) run was cancelled.
+    bool isCancelled() const;
+
+    /// @brief Gets the fraction of the current run's shoes that have been played, from 0
+    /// to 1. May be called from any thread.
+    double getProgress() const;
+
+    /// @brief Gets the number of rounds played so far in the current run, counting only
+    /// finished shoes. May be called from any thread.
+    qint64 getRoundsPlayed() const;
+
+    /// @brief Gets the entrants.
+    const QVector<Entrant>& getEntrants() const { return entrants_; }
+
+private:
+    /// @brief The engines, strategies, and totals of one thread, on their own cache lines.
+    struct alignas(64) Worker {
+        Worker(const Ruleset& rules, const QVector<Entrant>& entrants);
+
+        /// @brief The reference's engine, whose shoe every round is dealt from.
+        RoundEngine reference;
+
+        /// @brief The engine the other entrants play each round on, copied from the
+        /// reference's before the round.
+        RoundEngine challenger;
+
+        std::vector<std::unique_ptr<PlayerStrategy>> strategies;
+        std::vector<qint64> nets;
+        TournamentStats stats;
+    };
+
+    /// @brief Plays one shoe on the calling thread.
+    /// @return The number of rounds played.
+    qint64 runShoe(Worker& worker, quint64 seed, qint64 shoe) const;
+
+    /// @brief The rules to play under.
+    Ruleset rules_;
+
+    /// @brief The strategies to compare.
+    QVector<Entrant> entrants_;
+
+    /// @brief Shares the shoes among the threads.
+    WorkStealingScheduler scheduler_;
+
+    /// @brief The number of rounds in the current run's finished shoes.
+    std::atomic<qint64> roundsPlayed_;
+};
+
+#endif // STRATEGY_TOURNAMENT_H
@@ -0,0 +1,114 @@
+#include "work_stealing_scheduler.h"
+#include <thread>
+#include <vector>
+
+WorkStealingScheduler::WorkStealingScheduler() :
+    workerCount_(0), taskCount_(0), startedTasks_(0), completedTasks_(0), cancelled_(false)
+{}
+
+bool WorkStealingScheduler::run(qint64 taskCount, int threads, const Task& task) {
+    taskCount = qBound<qint64>(0, taskCount, MAX_TASKS);
+    threads = static_cast<int>(qBound<qint64>(1, threads, qMax<qint64>(taskCount, 1)));
+
+    // Deal the tasks out evenly to start with; stealing evens out the rest
+    ranges_.reset(new WorkerRange[threads]);
+    for (int i = 0; i < threads; ++i) {
+        quint64 begin = static_cast<quint64>(taskCount * i / threads);
+        quint64 end = static_cast<quint64>(taskCount * (i + 1) / threads);
+        ranges_[i].range.store(pack(begin, end), std::memory_order_relaxed);
+    }
+    workerCount_ = threads;
+    taskCount_ = taskCount;
+    startedTasks_ = 0;
+    completedTasks_ = 0;
+    cancelled_ = false;
+
+    auto work = [this, &task](int worker) {
+        while (!isCancelled()) {
+            qint64 next;
+            if (!take(worker, next) && !steal(worker, next)) {
+                // A failed steal while tasks are still unstarted means a thief is handing
+                // a stolen range over to itself; there may be more to steal once it has
+                if (startedTasks_.load() >= taskCount_.load())
+                    break;
+                std::this_thread::yield();
+                continue;
+            }
+            task(worker, next);
+            completedTasks_.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (int i = 1; i < threads; ++i)
+        workers.emplace_back(work, i);
+    work(0);
+    for (std::thread& worker : workers)
+        worker.join();
+    return !isCancelled();
+}
+
+void WorkStealingScheduler::cancel() {
+    cancelled_ = true;
+}
+
+qint64 WorkStealingScheduler::getCompletedTasks() const {
+    return completedTasks_.load(std::memory_order_relaxed);
+}
+
+qint64 WorkStealingScheduler::getTaskCount() const {
+    return taskCount_.load(std::memory_order_relaxed);
+}
+
+bool WorkStealingScheduler::take(int worker, qint64& task) {
+    std::atomic<quint64>& range = ranges_[worker].range;
+    quint64 current = range.load();
+    while (true) {
+        quint64 begin = current >> 32;
+        quint64 end = current & 0xFFFFFFFFu;
+        if (begin >= end)
+            return false;
+        if (range.compare_exchange_weak(current, pack(begin + 1, end))) {
+            startedTasks_.fetch_add(1);
+            task = static_cast<qint64>(begin);
+            return true;
+        }
+    }
+}
+
+bool WorkStealingScheduler::steal(int thief, qint64& task) {
+    while (true) {
+        // Find the worker with the most tasks left, starting after the thief so that
+        // thieves spread out over the victims
+        int victim = -1;
+        quint64 victimRange = 0;
+        quint64 mostLeft = 0;
+        for (int offset = 1; offset < workerCount_; ++offset) {
+            int worker = (thief + offset) % workerCount_;
+            quint64 current = ranges_[worker].range.load();
+            quint64 left = (current & 0xFFFFFFFFu) - qMin(current >> 32, current & 0xFFFFFFFFu);
+            if (left > mostLeft) {
+                victim = worker;
+                victimRange = current;
+                mostLeft = left;
+            }
+        }
+        if (victim < 0)
+            return false;
+
+        // Take the back half (rounded up, so a single task can be stolen). If the victim
+        // or another thief changed the range first, look again.
+        quint64 begin = victimRange >> 32;
+        quint64 end = victimRange & 0xFFFFFFFFu;
+        quint64 split = end - (mostLeft + 1) / 2;
+        if (!ranges_[victim].range.compare_exchange_strong(victimRange, pack(begin, split)))
+            continue;
+
+        // The thief's own range is empty, so no one else will touch it while it is set
+        ranges_[thief].range.store(pack(split + 1, end));
+        startedTasks_.fetch_add(1);
+        task = static_cast<qint64>(split);
+        return true;
+    }
+}
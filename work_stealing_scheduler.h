@@ -0,0 +1,101 @@
+#ifndef WORK_STEALING_SCHEDULER_H
+#define WORK_STEALING_SCHEDULER_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <QtGlobal>
+
+/// @brief Runs a numbered set of independent tasks on several threads, balancing them by
+/// work stealing.
+///
+/// The tasks start divided evenly among the workers, each of which owns a range of task
+/// numbers packed into a single atomic word. A worker takes tasks from the front of its
+/// own range; once the range is empty, it steals the back half of the largest range left
+/// and carries on with that. Taking and stealing are both a single compare-and-swap, so
+/// no locks are held, and workers that draw short tasks simply end up running more of
+/// them.
+///
+/// Progress and cancellation may be checked or requested from any thread while run is
+/// running.
+class WorkStealingScheduler {
+public:
+    /// @brief Runs one task on a worker thread.
+    /// @param worker The index of the worker, from 0 to the number of threads - 1, so the
+    /// task can add its results to that worker's own accumulator.
+    /// @param task The number of the task, from 0 to the number of tasks - 1.
+    using Task = std::function<void(int worker, qint64 task)>;
+
+    /// @brief The largest number of tasks a single run can schedule.
+    static constexpr qint64 MAX_TASKS = 0xFFFFFFFFll;
+
+    /// @brief Creates a new WorkStealingScheduler.
+    WorkStealingScheduler();
+
+    /// @brief Runs tasks 0 to taskCount - 1, and returns once they are all finished or the
+    /// run is cancelled. Each task is run exactly once unless the run is cancelled.
+    /// @param taskCount The number of tasks (at most MAX_TASKS).
+    /// @param threads The number of threads to run on (at least 1).
+    /// @param task Runs one task.
+    /// @return True if every task was run; false if the run was cancelled.
+    bool run(qint64 taskCount, int threads, const Task& task);
+
+    /// @brief Cancels the current run: no task is started after this is called, though
+    /// tasks already running finish (or may check isCancelled to stop early). A
+    /// cancellation stays in effect until the next run starts.
+    void cancel();
+
+    /// @brief Returns true if the current (or last) run has been cancelled.
+    bool isCancelled() const {
+        return cancelled_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Gets the number of tasks of the current (or last) run that have finished.
+    qint64 getCompletedTasks() const;
+
+    /// @brief Gets the number of tasks in the current (or last) run.
+    qint64 getTaskCount() const;
+
+private:
+    /// @brief The range of task numbers a worker has yet to start, with the first task in
+    /// the high 32 bits and one past the last task in the low 32 bits. Each range has a
+    /// cache line to itself so workers do not slow each other down.
+    struct alignas(64) WorkerRange {
+        std::atomic<quint64> range;
+    };
+
+    /// @brief Packs a range of task numbers.
+    static quint64 pack(quint64 begin, quint64 end) {
+        return begin << 32 | end;
+    }
+
+    /// @brief Takes the first task of a worker's own range.
+    /// @return True if a task was taken; false if the range is empty.
+    bool take(int worker, qint64& task);
+
+    /// @brief Steals the back half of the largest range of another worker, keeping its
+    /// first task and making the rest the thief's own range.
+    /// @return True if a task was stolen; false if no other worker has tasks left.
+    bool steal(int thief, qint64& task);
+
+    /// @brief The range of each worker.
+    std::unique_ptr<WorkerRange[]> ranges_;
+
+    /// @brief The number of workers in the current run.
+    int workerCount_;
+
+    /// @brief The number of tasks in the current run.
+    std::atomic<qint64> taskCount_;
+
+    /// @brief The number of tasks taken from a range so far, used to tell when every task
+    /// has been started even while a stolen range is being handed over.
+    std::atomic<qint64> startedTasks_;
+
+    /// @brief The number of tasks finished so far.
+    std::atomic<qint64> completedTasks_;
+
+    /// @brief True once the current run has been cancelled.
+    std::atomic<bool> cancelled_;
+};
+
+#endif // WORK_STEALING_SCHEDULER_H